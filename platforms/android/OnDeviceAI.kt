@@ -10,8 +10,18 @@ package com.ondeviceai
 
 import android.app.Application
 import android.content.ComponentCallbacks2
+import android.content.Context
 import android.content.res.Configuration
+import android.os.Build
+import android.os.PowerManager
 import kotlinx.coroutines.*
+import java.lang.ref.PhantomReference
+import java.lang.ref.ReferenceQueue
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+import java.nio.FloatBuffer
+import java.util.concurrent.ConcurrentHashMap
+import java.util.concurrent.atomic.AtomicBoolean
 
 // ---------------------------------------------------------------------------
 // Configuration & Types
@@ -64,7 +74,9 @@ data class StorageInfo(
 data class GenerationConfig(
     val temperature: Double = 0.7,
     val topP: Double = 0.9,
-    val maxTokens: Int = 512
+    val maxTokens: Int = 512,
+    /** Tokens coalesced per streaming upcall; each callback receives a text chunk. */
+    val tokenBatchSize: Int = 1
 )
 
 data class SynthesisConfig(
@@ -73,6 +85,95 @@ data class SynthesisConfig(
     val pitch: Float = 1.0f
 )
 
+/**
+ * 32-bit float PCM held in native memory as a direct [ByteBuffer].
+ *
+ * Can be passed straight to `AudioTrack.write(ByteBuffer, ...)` or filled by
+ * `AudioRecord.read(ByteBuffer, ...)` with `ENCODING_PCM_FLOAT`, so samples
+ * never round-trip through a Java float array. Call [close] when done to
+ * return the memory to the native pool.
+ */
+class AudioBuffer internal constructor(
+    val data: ByteBuffer,
+    val sampleRate: Int = 16000
+) : AutoCloseable {
+
+    private val closed = AtomicBoolean(false)
+    private val cleanup: AudioBufferPool.Cleanup
+
+    init {
+        data.order(ByteOrder.nativeOrder())
+        cleanup = AudioBufferPool.register(data, closed)
+    }
+
+    /** Number of float samples the buffer can hold. */
+    val sampleCapacity: Int get() = data.capacity() / 4
+
+    /** True once the memory has been returned to the pool. */
+    val isClosed: Boolean get() = closed.get()
+
+    /** Float view over the same native memory. */
+    fun asFloatBuffer(): FloatBuffer = data.duplicate().order(ByteOrder.nativeOrder()).asFloatBuffer()
+
+    /** Return the memory to the pool. Idempotent; later calls do nothing. */
+    override fun close() = cleanup.run()
+}
+
+/**
+ * Native pool backing [AudioBuffer]s.
+ *
+ * A buffer that is never closed is released once its [ByteBuffer] becomes
+ * unreachable, so forgotten buffers do not stay checked out forever.
+ */
+object AudioBufferPool {
+
+    /** Get a pooled buffer holding at least [sampleCapacity] float samples. */
+    fun acquire(sampleCapacity: Int, sampleRate: Int = 16000): AudioBuffer =
+        AudioBuffer(nativeAcquire(sampleCapacity), sampleRate)
+
+    fun release(buffer: AudioBuffer) = buffer.close()
+
+    /** Releases one buffer at most once, from close() or the reaper thread. */
+    internal class Cleanup(
+        buffer: ByteBuffer,
+        private val address: Long,
+        private val closed: AtomicBoolean
+    ) : PhantomReference<ByteBuffer>(buffer, queue) {
+        fun run() {
+            tracked.remove(this)
+            if (closed.compareAndSet(false, true)) nativeRelease(address)
+        }
+    }
+
+    // Phantom references keep the cleanups reachable until they run;
+    // java.lang.ref.Cleaner needs API 33, so a daemon thread drains the queue.
+    private val queue = ReferenceQueue<ByteBuffer>()
+    private val tracked = ConcurrentHashMap.newKeySet<Cleanup>()
+
+    init {
+        Thread({
+            while (true) {
+                try {
+                    (queue.remove() as Cleanup).run()
+                } catch (_: InterruptedException) {
+                    return@Thread
+                }
+            }
+        }, "OnDeviceAI-AudioBufferReaper").apply {
+            isDaemon = true
+            start()
+        }
+    }
+
+    internal fun register(buffer: ByteBuffer, closed: AtomicBoolean): Cleanup =
+        Cleanup(buffer, nativeAddress(buffer), closed).also { tracked.add(it) }
+
+    // --- JNI ---
+    private external fun nativeAcquire(sampleCapacity: Int): ByteBuffer
+    private external fun nativeAddress(buffer: ByteBuffer): Long
+    private external fun nativeRelease(address: Long)
+}
+
 // ---------------------------------------------------------------------------
 // Main SDK Entry Point
 // ---------------------------------------------------------------------------
@@ -231,7 +332,10 @@ class LLMEngine {
         onToken: (String) -> Unit
     ) = withContext(Dispatchers.IO) {
         tokenCallback = onToken
-        nativeGenerateStreaming(handle, prompt, config.temperature, config.topP, config.maxTokens)
+        nativeGenerateStreaming(
+            handle, prompt, config.temperature, config.topP, config.maxTokens,
+            config.tokenBatchSize
+        )
         tokenCallback = null
     }
 
@@ -249,7 +353,8 @@ class LLMEngine {
     ): String
     private external fun nativeGenerateStreaming(
         handle: Long, prompt: String,
-        temperature: Double, topP: Double, maxTokens: Int
+        temperature: Double, topP: Double, maxTokens: Int,
+        tokenBatchSize: Int
     )
 }
 
@@ -273,12 +378,26 @@ class STTEngine {
         nativeTranscribe(handle, audioSamples, sampleRate)
     }
 
+    /**
+     * Transcribe the first [sampleCount] samples of a native [AudioBuffer],
+     * e.g. one filled by `AudioRecord.read(buffer.data, ...)`.
+     */
+    suspend fun transcribe(
+        handle: Long, audio: AudioBuffer, sampleCount: Int = audio.sampleCapacity
+    ): String = withContext(Dispatchers.IO) {
+        require(sampleCount in 0..audio.sampleCapacity) { "sampleCount exceeds buffer capacity" }
+        nativeTranscribeDirect(handle, audio.data, sampleCount, audio.sampleRate)
+    }
+
     // --- JNI ---
     private external fun nativeLoadModel(path: String): Long
     private external fun nativeUnloadModel(handle: Long)
     private external fun nativeTranscribe(
         handle: Long, audioSamples: FloatArray, sampleRate: Int
     ): String
+    private external fun nativeTranscribeDirect(
+        handle: Long, audioBuffer: ByteBuffer, sampleCount: Int, sampleRate: Int
+    ): String
 }
 
 // ---------------------------------------------------------------------------
@@ -302,6 +421,21 @@ class TTSEngine {
         nativeSynthesize(handle, text, config.voiceId, config.speed, config.pitch)
     }
 
+    /**
+     * Synthesize into a pooled native [AudioBuffer] that can be handed to
+     * `AudioTrack.write(buffer.data, ...)` without copying. Close it after playback.
+     */
+    suspend fun synthesizeToBuffer(
+        handle: Long, text: String,
+        config: SynthesisConfig = SynthesisConfig(),
+        sampleRate: Int = 22050
+    ): AudioBuffer = withContext(Dispatchers.IO) {
+        AudioBuffer(
+            nativeSynthesizeDirect(handle, text, config.voiceId, config.speed, config.pitch),
+            sampleRate
+        )
+    }
+
     // --- JNI ---
     private external fun nativeLoadModel(path: String): Long
     private external fun nativeUnloadModel(handle: Long)
@@ -309,6 +443,10 @@ class TTSEngine {
         handle: Long, text: String,
         voiceId: String, speed: Float, pitch: Float
     ): FloatArray
+    private external fun nativeSynthesizeDirect(
+        handle: Long, text: String,
+        voiceId: String, speed: Float, pitch: Float
+    ): ByteBuffer
 }
 
 // ---------------------------------------------------------------------------
@@ -353,16 +491,27 @@ class LifecycleManager : ComponentCallbacks2 {
     private var pauseInferenceOnBackground = false
     private var application: Application? = null
 
+    private var adaptivePerformance = false
+    private var baseThreadCount = SDKConfig.DEFAULT.threadCount
+    private var appliedThreadCount = 0
+    private val governorLock = Any()
+    private var thermalListener: Any? = null
+
+    /** Called with (thermal status, thread count) whenever the governor changes the thread count. */
+    @Volatile var onThermalAdjustment: ((Int, Int) -> Unit)? = null
+
     fun startObserving(app: Application? = null) {
         if (isObserving) return
         application = app
         app?.registerComponentCallbacks(this)
+        registerThermalListener(app)
         isObserving = true
     }
 
     fun stopObserving() {
         if (!isObserving) return
         application?.unregisterComponentCallbacks(this)
+        unregisterThermalListener()
         isObserving = false
     }
 
@@ -372,6 +521,68 @@ class LifecycleManager : ComponentCallbacks2 {
 
     fun isPauseInferenceOnBackgroundEnabled(): Boolean = pauseInferenceOnBackground
 
+    // --- Adaptive performance (thermal governor) ---
+
+    /**
+     * Enable or disable thermal-aware thread count adjustment.
+     * While enabled, the SDK thread count steps down from [baseThreadCount]
+     * as PowerManager's thermal status rises (Android 10+). Disabling restores
+     * the base thread count only if the governor had lowered it.
+     */
+    fun setAdaptivePerformance(enabled: Boolean, baseThreadCount: Int = SDKConfig.DEFAULT.threadCount) {
+        val restore: Int? = synchronized(governorLock) {
+            val lowered = adaptivePerformance && appliedThreadCount != 0 &&
+                appliedThreadCount != this.baseThreadCount
+            val previousBase = this.baseThreadCount
+            adaptivePerformance = enabled
+            this.baseThreadCount = maxOf(baseThreadCount, 1)
+            appliedThreadCount = 0
+            if (!enabled && lowered) previousBase else null
+        }
+        if (enabled) {
+            currentThermalStatus()?.let { onThermalStatusChanged(it) }
+        } else if (restore != null) {
+            OnDeviceAI.getInstance()?.setThreadCount(restore)
+        }
+    }
+
+    fun isAdaptivePerformanceEnabled(): Boolean = synchronized(governorLock) { adaptivePerformance }
+
+    /** Called from the PowerManager listener thread and from [setAdaptivePerformance]. */
+    internal fun onThermalStatusChanged(status: Int) {
+        val threads = synchronized(governorLock) {
+            if (!adaptivePerformance) return
+            val threads = threadCountForThermalStatus(status, baseThreadCount)
+            if (threads == appliedThreadCount) return
+            appliedThreadCount = threads
+            OnDeviceAI.getInstance()?.setThreadCount(threads)
+            threads
+        }
+        onThermalAdjustment?.invoke(status, threads)
+    }
+
+    private fun currentThermalStatus(): Int? {
+        if (Build.VERSION.SDK_INT < Build.VERSION_CODES.Q) return null
+        val pm = application?.getSystemService(Context.POWER_SERVICE) as? PowerManager
+        return pm?.currentThermalStatus
+    }
+
+    private fun registerThermalListener(app: Application?) {
+        if (app == null || Build.VERSION.SDK_INT < Build.VERSION_CODES.Q) return
+        val pm = app.getSystemService(Context.POWER_SERVICE) as? PowerManager ?: return
+        val listener = PowerManager.OnThermalStatusChangedListener { onThermalStatusChanged(it) }
+        pm.addThermalStatusListener(listener)
+        thermalListener = listener
+    }
+
+    private fun unregisterThermalListener() {
+        if (Build.VERSION.SDK_INT < Build.VERSION_CODES.Q) return
+        val listener = thermalListener as? PowerManager.OnThermalStatusChangedListener ?: return
+        val pm = application?.getSystemService(Context.POWER_SERVICE) as? PowerManager
+        pm?.removeThermalStatusListener(listener)
+        thermalListener = null
+    }
+
     fun getCurrentMemoryUsage(): Long = nativeGetMemoryUsage()
     fun getMemoryLimit(): Long = nativeGetMemoryLimit()
     fun isMemoryPressure(): Boolean = nativeIsMemoryPressure()
@@ -410,4 +621,17 @@ class LifecycleManager : ComponentCallbacks2 {
     private external fun nativeGetMemoryUsage(): Long
     private external fun nativeGetMemoryLimit(): Long
     private external fun nativeIsMemoryPressure(): Boolean
+
+    companion object {
+        /** Thread count the governor applies for a PowerManager.THERMAL_STATUS_* level. */
+        fun threadCountForThermalStatus(status: Int, baseThreadCount: Int): Int {
+            val base = maxOf(baseThreadCount, 1)
+            return when {
+                status >= PowerManager.THERMAL_STATUS_CRITICAL -> 1
+                status >= PowerManager.THERMAL_STATUS_SEVERE -> maxOf(base / 2, 1)
+                status >= PowerManager.THERMAL_STATUS_MODERATE -> maxOf(base * 3 / 4, 1)
+                else -> base
+            }
+        }
+    }
 }
@@ -16,11 +16,17 @@
 #include "ondeviceai/memory_manager.hpp"
 #include "ondeviceai/logger.hpp"
 #include "ondeviceai/types.hpp"
+#include "../../common/utf8_prefix.h"
+#include "../../common/stream_completion.h"
 
 #include <jni.h>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 #include <mutex>
+#include <unordered_map>
 #include <android/log.h>
 
 #define LOG_TAG "OnDeviceAI_JNI"
@@ -49,49 +55,266 @@ jstring stringToJstring(JNIEnv* env, const std::string& str) {
     return env->NewStringUTF(str.c_str());
 }
 
-/// Throw a Java exception wrapping an SDK error
-void throwSDKError(JNIEnv* env, const Error& error) {
-    jclass cls = env->FindClass("com/ondeviceai/SDKError");
-    if (cls) {
-        jmethodID ctor = env->GetMethodID(cls, "<init>",
+/// Class refs and method IDs resolved once in JNI_OnLoad. FindClass from a
+/// native thread only sees the system class loader, so app classes must be
+/// looked up while the loading thread's class loader is active.
+struct JNICache {
+    jclass    sdkErrorClass      = nullptr;
+    jmethodID sdkErrorCtor       = nullptr;
+    jclass    runtimeException   = nullptr;
+    jmethodID llmOnNativeToken   = nullptr;
+};
+
+JNICache g_cache;
+
+/// Resolve a class and pin it with a global ref (nullptr if missing)
+jclass findGlobalClass(JNIEnv* env, const char* name) {
+    jclass local = env->FindClass(name);
+    if (!local) {
+        env->ExceptionClear();
+        return nullptr;
+    }
+    auto global = static_cast<jclass>(env->NewGlobalRef(local));
+    env->DeleteLocalRef(local);
+    return global;
+}
+
+void initJNICache(JNIEnv* env) {
+    g_cache.sdkErrorClass = findGlobalClass(env, "com/ondeviceai/SDKError");
+    if (g_cache.sdkErrorClass) {
+        g_cache.sdkErrorCtor = env->GetMethodID(g_cache.sdkErrorClass, "<init>",
             "(ILjava/lang/String;Ljava/lang/String;Ljava/lang/String;)V");
-        if (ctor) {
-            jstring msg  = stringToJstring(env, error.message);
-            jstring det  = stringToJstring(env, error.details);
-            jstring rec  = stringToJstring(env, error.recovery_suggestion);
-            jthrowable ex = static_cast<jthrowable>(
-                env->NewObject(cls, ctor,
-                    static_cast<jint>(error.code), msg, det, rec));
-            env->Throw(ex);
-            env->DeleteLocalRef(msg);
-            env->DeleteLocalRef(det);
-            env->DeleteLocalRef(rec);
-            return;
-        }
     }
-    // Fallback: plain RuntimeException
-    jclass rte = env->FindClass("java/lang/RuntimeException");
-    env->ThrowNew(rte, error.message.c_str());
+    g_cache.runtimeException = findGlobalClass(env, "java/lang/RuntimeException");
+
+    jclass llmClass = env->FindClass("com/ondeviceai/LLMEngine");
+    if (llmClass) {
+        g_cache.llmOnNativeToken = env->GetMethodID(llmClass, "onNativeToken", "(Ljava/lang/String;)V");
+        env->DeleteLocalRef(llmClass);
+    }
+    if (env->ExceptionCheck()) {
+        env->ExceptionClear();
+    }
+}
+
+void releaseJNICache(JNIEnv* env) {
+    if (g_cache.sdkErrorClass) env->DeleteGlobalRef(g_cache.sdkErrorClass);
+    if (g_cache.runtimeException) env->DeleteGlobalRef(g_cache.runtimeException);
+    g_cache = JNICache{};
 }
 
 /// Throw a generic RuntimeException
 void throwRuntime(JNIEnv* env, const char* msg) {
-    jclass rte = env->FindClass("java/lang/RuntimeException");
+    jclass rte = g_cache.runtimeException
+        ? g_cache.runtimeException
+        : env->FindClass("java/lang/RuntimeException");
     env->ThrowNew(rte, msg);
 }
 
+/// Throw a Java exception wrapping an SDK error
+void throwSDKError(JNIEnv* env, const Error& error) {
+    if (g_cache.sdkErrorClass && g_cache.sdkErrorCtor) {
+        jstring msg  = stringToJstring(env, error.message);
+        jstring det  = stringToJstring(env, error.details);
+        jstring rec  = stringToJstring(env, error.recovery_suggestion);
+        jthrowable ex = static_cast<jthrowable>(
+            env->NewObject(g_cache.sdkErrorClass, g_cache.sdkErrorCtor,
+                static_cast<jint>(error.code), msg, det, rec));
+        env->Throw(ex);
+        env->DeleteLocalRef(msg);
+        env->DeleteLocalRef(det);
+        env->DeleteLocalRef(rec);
+        return;
+    }
+    // Fallback: plain RuntimeException
+    throwRuntime(env, error.message.c_str());
+}
+
+using bridge::completeUtf8Prefix;
+
+/// Pool of native float buffers handed to Kotlin as direct ByteBuffers.
+/// Audio crosses JNI without a jfloatArray, and buffers are recycled instead
+/// of being reallocated for every utterance.
+class AudioBufferPool {
+public:
+    /// Get a buffer holding at least `samples` floats
+    float* acquire(size_t samples) {
+        if (samples == 0) samples = 1;
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        // Smallest pooled buffer that fits
+        auto best = free_.end();
+        for (auto it = free_.begin(); it != free_.end(); ++it) {
+            if (it->size() >= samples && (best == free_.end() || it->size() < best->size())) {
+                best = it;
+            }
+        }
+
+        std::vector<float> buffer;
+        if (best != free_.end()) {
+            buffer = std::move(*best);
+            free_.erase(best);
+        } else {
+            buffer.resize(samples);
+        }
+
+        float* data = buffer.data();
+        in_use_[data] = Entry{std::move(buffer), false, false};
+        return data;
+    }
+
+    /// Return a buffer obtained from acquire(); unknown addresses are ignored.
+    /// A buffer that is currently lent out is recycled when it comes back.
+    void release(void* address) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = in_use_.find(address);
+        if (it == in_use_.end()) return;
+        if (it->second.lent) {
+            it->second.release_pending = true;
+            return;
+        }
+        recycle(it);
+    }
+
+    /// Move the pooled vector at `address` into `out`, trimmed to `samples`,
+    /// so it can back an AudioData without copying. The data pointer is
+    /// unchanged. Returns false for non-pooled or already lent buffers.
+    bool lend(void* address, size_t samples, std::vector<float>& out, size_t& original_size) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = in_use_.find(address);
+        if (it == in_use_.end() || it->second.lent || samples > it->second.buffer.size()) {
+            return false;
+        }
+        original_size = it->second.buffer.size();
+        out = std::move(it->second.buffer);
+        out.resize(samples);  // shrinking never reallocates
+        it->second.lent = true;
+        return true;
+    }
+
+    /// Give back a vector obtained from lend()
+    void giveBack(void* address, std::vector<float>&& buffer, size_t original_size) {
+        buffer.resize(original_size);  // within capacity, same data pointer
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = in_use_.find(address);
+        if (it == in_use_.end()) return;
+        it->second.buffer = std::move(buffer);
+        it->second.lent = false;
+        if (it->second.release_pending) recycle(it);
+    }
+
+private:
+    static constexpr size_t kMaxPooledBuffers = 8;
+
+    struct Entry {
+        std::vector<float> buffer;
+        bool lent;
+        bool release_pending;
+    };
+
+    void recycle(std::unordered_map<void*, Entry>::iterator it) {
+        if (free_.size() < kMaxPooledBuffers) {
+            free_.push_back(std::move(it->second.buffer));
+        }
+        in_use_.erase(it);
+    }
+
+    std::mutex mutex_;
+    std::vector<std::vector<float>> free_;
+    std::unordered_map<void*, Entry> in_use_;
+};
+
+AudioBufferPool& audioBufferPool() {
+    static AudioBufferPool pool;
+    return pool;
+}
+
+/// Wrap `samples` floats of pooled memory in a direct ByteBuffer
+jobject newPooledAudioBuffer(JNIEnv* env, size_t samples) {
+    float* data = audioBufferPool().acquire(samples);
+    jobject buffer = env->NewDirectByteBuffer(data, static_cast<jlong>(samples * sizeof(float)));
+    if (!buffer) {
+        audioBufferPool().release(data);
+    }
+    return buffer;
+}
+
 /// Global reference to the cached JavaVM (set in JNI_OnLoad)
 JavaVM* g_jvm = nullptr;
 
-/// Get JNIEnv for the current thread
+/// Keeps a native callback thread attached to the JVM for its whole lifetime
+/// and detaches it on thread exit, instead of attaching per callback.
+struct ThreadAttachGuard {
+    JNIEnv* env = nullptr;
+    bool attached = false;
+
+    ~ThreadAttachGuard() {
+        if (attached && g_jvm) {
+            g_jvm->DetachCurrentThread();
+        }
+    }
+};
+
+/// Get JNIEnv for the current thread, attaching it on first use
 JNIEnv* getEnv() {
+    thread_local ThreadAttachGuard guard;
+    if (guard.env) return guard.env;
+    if (!g_jvm) return nullptr;
+
     JNIEnv* env = nullptr;
-    if (g_jvm) {
-        g_jvm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_6);
+    jint status = g_jvm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_6);
+    if (status == JNI_EDETACHED) {
+        if (g_jvm->AttachCurrentThread(&env, nullptr) != JNI_OK) {
+            return nullptr;
+        }
+        guard.attached = true;
+    } else if (status != JNI_OK) {
+        return nullptr;
     }
+    guard.env = env;
     return env;
 }
 
+/// Per-request streaming state shared with dispatcher callbacks. All fields
+/// are guarded by `mutex`, which serializes upcalls. Chunk order follows
+/// callback order, which matches generation order only because
+/// nativeInitialize runs the dispatcher with a single callback thread.
+struct TokenStream {
+    std::mutex mutex;
+    std::string pending;
+    int pendingTokens = 0;
+    int batchSize = 1;
+    bool closed = false;
+    jobject target = nullptr;
+    jmethodID onToken = nullptr;
+
+    /// Pushes the UTF-8-complete part of `pending` to Kotlin; a trailing
+    /// partial code point stays buffered unless `force` is set. A Kotlin
+    /// exception closes the stream and drops the remaining tokens.
+    void flush(JNIEnv* env, bool force) {
+        if (closed || !target) return;
+        size_t ready = force ? pending.size() : completeUtf8Prefix(pending);
+        pendingTokens = 0;
+        if (ready == 0) return;
+        jstring jChunk;
+        if (ready == pending.size()) {
+            jChunk = env->NewStringUTF(pending.c_str());
+            pending.clear();
+        } else {
+            std::string head = pending.substr(0, ready);
+            jChunk = env->NewStringUTF(head.c_str());
+            pending.erase(0, ready);
+        }
+        env->CallVoidMethod(target, onToken, jChunk);
+        env->DeleteLocalRef(jChunk);
+        if (env->ExceptionCheck()) {
+            env->ExceptionClear();
+            closed = true;
+            pending.clear();
+        }
+    }
+};
+
 } // anonymous namespace
 
 // ---------------------------------------------------------------------------
@@ -100,6 +323,10 @@ JNIEnv* getEnv() {
 
 JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM* vm, void* /*reserved*/) {
     g_jvm = vm;
+    JNIEnv* env = nullptr;
+    if (vm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_6) == JNI_OK) {
+        initJNICache(env);
+    }
     LOGI("OnDeviceAI JNI library loaded");
     return JNI_VERSION_1_6;
 }
@@ -107,6 +334,10 @@ JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM* vm, void* /*reserved*/) {
 JNIEXPORT void JNICALL JNI_OnUnload(JavaVM* /*vm*/, void* /*reserved*/) {
     LOGI("OnDeviceAI JNI library unloading");
     SDKManager::shutdown();
+    JNIEnv* env = nullptr;
+    if (g_jvm && g_jvm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_6) == JNI_OK) {
+        releaseJNICache(env);
+    }
     g_jvm = nullptr;
 }
 
@@ -126,6 +357,8 @@ Java_com_ondeviceai_OnDeviceAI_nativeInitialize(
     config.thread_count    = static_cast<int>(threadCount);
     config.memory_limit    = static_cast<size_t>(memoryLimitBytes);
     config.log_level       = LogLevel::Info;
+    // Streamed chunks are ordered by callback order (see TokenStream)
+    config.callback_thread_count = 1;
 
     auto result = SDKManager::initialize(config);
     if (result.isError()) {
@@ -220,7 +453,7 @@ Java_com_ondeviceai_LLMEngine_nativeGenerate(
 JNIEXPORT void JNICALL
 Java_com_ondeviceai_LLMEngine_nativeGenerateStreaming(
     JNIEnv* env, jobject obj, jlong handle, jstring prompt,
-    jdouble temperature, jdouble topP, jint maxTokens)
+    jdouble temperature, jdouble topP, jint maxTokens, jint tokenBatchSize)
 {
     auto* mgr = SDKManager::getInstance();
     if (!mgr) { throwRuntime(env, "SDK not initialized"); return; }
@@ -232,34 +465,52 @@ Java_com_ondeviceai_LLMEngine_nativeGenerateStreaming(
     config.top_p       = static_cast<float>(topP);
     config.max_tokens  = static_cast<int>(maxTokens);
 
-    // Get the Kotlin callback method
-    jclass cls = env->GetObjectClass(obj);
-    jmethodID onTokenMethod = env->GetMethodID(cls, "onNativeToken", "(Ljava/lang/String;)V");
+    // Kotlin callback method, resolved once in JNI_OnLoad
+    jmethodID onTokenMethod = g_cache.llmOnNativeToken;
     if (!onTokenMethod) {
         throwRuntime(env, "onNativeToken method not found on LLMEngine");
         return;
     }
 
-    // Create a weak global ref so the callback can survive across JNI calls
-    jobject globalObj = env->NewGlobalRef(obj);
+    // Tokens are coalesced into one reusable buffer and pushed to Kotlin every
+    // `batchSize` tokens, so a single upcall and jstring covers several tokens.
+    // The state is heap-owned: the dispatcher may run callbacks on its own
+    // threads, concurrently, and after this frame has returned.
+    auto stream = std::make_shared<TokenStream>();
+    stream->target = env->NewGlobalRef(obj);
+    stream->onToken = onTokenMethod;
+    stream->batchSize = tokenBatchSize > 0 ? static_cast<int>(tokenBatchSize) : 1;
+    stream->pending.reserve(256);
+
+    // Opens once the last queued copy of the token callback is destroyed,
+    // i.e. after this stream's final token, whatever other streams queue
+    auto drained = std::make_shared<bridge::CompletionLatch>();
+    auto completion = std::make_shared<bridge::StreamCompletion>([drained]() { drained->open(); });
 
     auto result = mgr->getLLMEngine()->generateStreaming(
-        static_cast<ModelHandle>(handle), promptStr, config,
-        [globalObj, onTokenMethod](const std::string& token) -> bool {
-            JNIEnv* cbEnv = getEnv();
-            if (!cbEnv) return false;
-            jstring jToken = cbEnv->NewStringUTF(token.c_str());
-            cbEnv->CallVoidMethod(globalObj, onTokenMethod, jToken);
-            cbEnv->DeleteLocalRef(jToken);
-            bool hasException = cbEnv->ExceptionCheck();
-            if (hasException) {
-                cbEnv->ExceptionClear();
-                return false; // stop generation
-            }
-            return true; // continue
-        });
-
-    env->DeleteGlobalRef(globalObj);
+        static_cast<ModelHandle>(handle), promptStr,
+        // `completion` is only held, see above
+        [stream, completion](const std::string& token) {
+            std::lock_guard<std::mutex> lock(stream->mutex);
+            if (stream->closed) return;
+            stream->pending.append(token);
+            if (++stream->pendingTokens < stream->batchSize) return;
+            // Dispatcher threads attach to the JVM on first use
+            if (JNIEnv* cbEnv = getEnv()) stream->flush(cbEnv, false);
+        },
+        config);
+
+    // Push the remainder only after this stream's callbacks have drained,
+    // so nothing arrives after the call returns
+    completion.reset();
+    drained->wait();
+    {
+        std::lock_guard<std::mutex> lock(stream->mutex);
+        stream->flush(env, true);
+        stream->closed = true;
+        env->DeleteGlobalRef(stream->target);
+        stream->target = nullptr;
+    }
 
     if (result.isError()) {
         throwSDKError(env, result.error());
@@ -329,6 +580,49 @@ Java_com_ondeviceai_STTEngine_nativeTranscribe(
     return stringToJstring(env, result.value().text);
 }
 
+JNIEXPORT jstring JNICALL
+Java_com_ondeviceai_STTEngine_nativeTranscribeDirect(
+    JNIEnv* env, jobject /*obj*/, jlong handle, jobject audioBuffer,
+    jint sampleCount, jint sampleRate)
+{
+    auto* mgr = SDKManager::getInstance();
+    if (!mgr) { throwRuntime(env, "SDK not initialized"); return nullptr; }
+
+    auto* data = static_cast<const float*>(env->GetDirectBufferAddress(audioBuffer));
+    jlong capacity = env->GetDirectBufferCapacity(audioBuffer);
+    if (!data || sampleCount < 0 ||
+        static_cast<jlong>(sampleCount) * static_cast<jlong>(sizeof(float)) > capacity) {
+        throwRuntime(env, "Audio buffer must be a direct ByteBuffer holding sampleCount floats");
+        return nullptr;
+    }
+
+    // Pooled buffers (AudioBufferPool.acquire) are lent to AudioData as is, so
+    // the samples AudioRecord wrote are transcribed in place. Other direct
+    // buffers are copied once, since AudioData owns a std::vector.
+    void* address = const_cast<float*>(data);
+    AudioData audio;
+    size_t pooledSize = 0;
+    const bool lent = audioBufferPool().lend(
+        address, static_cast<size_t>(sampleCount), audio.samples, pooledSize);
+    if (!lent) {
+        audio.samples.assign(data, data + sampleCount);
+    }
+    audio.sample_rate = static_cast<int>(sampleRate);
+    audio.channels    = 1;
+
+    TranscriptionConfig tConfig;
+    auto result = mgr->getSTTEngine()->transcribe(
+        static_cast<ModelHandle>(handle), audio, tConfig);
+    if (lent) {
+        audioBufferPool().giveBack(address, std::move(audio.samples), pooledSize);
+    }
+    if (result.isError()) {
+        throwSDKError(env, result.error());
+        return nullptr;
+    }
+    return stringToJstring(env, result.value().text);
+}
+
 // ---------------------------------------------------------------------------
 // TTS Engine
 // ---------------------------------------------------------------------------
@@ -393,6 +687,76 @@ Java_com_ondeviceai_TTSEngine_nativeSynthesize(
     return jsamples;
 }
 
+JNIEXPORT jobject JNICALL
+Java_com_ondeviceai_TTSEngine_nativeSynthesizeDirect(
+    JNIEnv* env, jobject /*obj*/, jlong handle, jstring text,
+    jstring voiceId, jfloat speed, jfloat pitch)
+{
+    auto* mgr = SDKManager::getInstance();
+    if (!mgr) { throwRuntime(env, "SDK not initialized"); return nullptr; }
+
+    std::string textStr = jstringToString(env, text);
+
+    SynthesisConfig sConfig;
+    sConfig.voice_id = jstringToString(env, voiceId);
+    sConfig.speed    = speed;
+    sConfig.pitch    = pitch;
+
+    auto result = mgr->getTTSEngine()->synthesize(
+        static_cast<ModelHandle>(handle), textStr, sConfig);
+    if (result.isError()) {
+        throwSDKError(env, result.error());
+        return nullptr;
+    }
+
+    // Samples land in pooled native memory that Kotlin passes to AudioTrack as is
+    const auto& audioData = result.value();
+    jobject buffer = newPooledAudioBuffer(env, audioData.samples.size());
+    if (!buffer) {
+        throwRuntime(env, "Failed to allocate direct audio buffer");
+        return nullptr;
+    }
+    std::copy(audioData.samples.begin(), audioData.samples.end(),
+              static_cast<float*>(env->GetDirectBufferAddress(buffer)));
+    return buffer;
+}
+
+// ---------------------------------------------------------------------------
+// Native audio buffer pool
+// ---------------------------------------------------------------------------
+
+JNIEXPORT jobject JNICALL
+Java_com_ondeviceai_AudioBufferPool_nativeAcquire(
+    JNIEnv* env, jobject /*obj*/, jint sampleCapacity)
+{
+    if (sampleCapacity < 0) {
+        throwRuntime(env, "sampleCapacity must be non-negative");
+        return nullptr;
+    }
+    jobject buffer = newPooledAudioBuffer(env, static_cast<size_t>(sampleCapacity));
+    if (!buffer) {
+        throwRuntime(env, "Failed to allocate direct audio buffer");
+    }
+    return buffer;
+}
+
+JNIEXPORT jlong JNICALL
+Java_com_ondeviceai_AudioBufferPool_nativeAddress(
+    JNIEnv* env, jobject /*obj*/, jobject buffer)
+{
+    if (!buffer) return 0;
+    return static_cast<jlong>(reinterpret_cast<intptr_t>(env->GetDirectBufferAddress(buffer)));
+}
+
+JNIEXPORT void JNICALL
+Java_com_ondeviceai_AudioBufferPool_nativeRelease(
+    JNIEnv* /*env*/, jobject /*obj*/, jlong address)
+{
+    if (address != 0) {
+        audioBufferPool().release(reinterpret_cast<void*>(static_cast<intptr_t>(address)));
+    }
+}
+
 // ---------------------------------------------------------------------------
 // Voice Pipeline
 // ---------------------------------------------------------------------------
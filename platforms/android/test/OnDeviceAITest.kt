@@ -1,5 +1,6 @@
 package com.ondeviceai
 
+import android.os.PowerManager
 import kotlinx.coroutines.test.runTest
 import org.junit.Assert.*
 import org.junit.Test
@@ -119,6 +120,17 @@ class OnDeviceAITest {
         assertTrue(lm.isPauseInferenceOnBackgroundEnabled())
     }
 
+    @Test
+    fun `thermal governor steps thread count down with thermal status`() {
+        assertEquals(8, LifecycleManager.threadCountForThermalStatus(PowerManager.THERMAL_STATUS_NONE, 8))
+        assertEquals(8, LifecycleManager.threadCountForThermalStatus(PowerManager.THERMAL_STATUS_LIGHT, 8))
+        assertEquals(6, LifecycleManager.threadCountForThermalStatus(PowerManager.THERMAL_STATUS_MODERATE, 8))
+        assertEquals(4, LifecycleManager.threadCountForThermalStatus(PowerManager.THERMAL_STATUS_SEVERE, 8))
+        assertEquals(1, LifecycleManager.threadCountForThermalStatus(PowerManager.THERMAL_STATUS_CRITICAL, 8))
+        // Never drops below one thread
+        assertEquals(1, LifecycleManager.threadCountForThermalStatus(PowerManager.THERMAL_STATUS_SEVERE, 1))
+    }
+
     // -----------------------------------------------------------------------
     // ModelManager runs on IO dispatcher (coroutine structure)
     // -----------------------------------------------------------------------
@@ -0,0 +1,66 @@
+/*
+ * stream_completion.h
+ * OnDevice AI SDK - shared helpers for the platform bindings
+ *
+ * A streaming call returns once decoding ends, but its token callbacks may
+ * still be queued on the core's CallbackDispatcher. Waiting for the whole
+ * dispatcher would block one stream behind every other stream's callbacks,
+ * so each stream tracks its own: every queued dispatch holds a copy of the
+ * token callback, and the callback holds a shared StreamCompletion. The
+ * completion fires when the last copy is destroyed, i.e. after this
+ * stream's final callback has run.
+ * Requirements: 7.2, 7.3, 7.8
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <utility>
+
+namespace ondeviceai {
+namespace bridge {
+
+/// Runs `onDrained` once when destroyed. Share it (std::shared_ptr) between
+/// the token callback and the caller; the caller drops its reference after
+/// generateStreaming() returns.
+class StreamCompletion {
+public:
+    explicit StreamCompletion(std::function<void()> onDrained)
+        : onDrained_(std::move(onDrained)) {}
+
+    ~StreamCompletion() {
+        if (onDrained_) onDrained_();
+    }
+
+    StreamCompletion(const StreamCompletion&) = delete;
+    StreamCompletion& operator=(const StreamCompletion&) = delete;
+
+private:
+    std::function<void()> onDrained_;
+};
+
+/// One-shot latch for bindings whose streaming call blocks until its own
+/// callbacks have drained.
+class CompletionLatch {
+public:
+    void open() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        open_ = true;
+        cv_.notify_all();
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return open_; });
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool open_ = false;
+};
+
+} // namespace bridge
+} // namespace ondeviceai
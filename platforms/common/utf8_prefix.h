@@ -0,0 +1,40 @@
+/*
+ * utf8_prefix.h
+ * OnDevice AI SDK - shared helpers for the platform bindings
+ *
+ * Token streams are forwarded in batches, and a token boundary can fall
+ * inside a multi-byte code point. Every binding (JNI, C ABI, WASM) holds
+ * back the incomplete tail with the same helper.
+ * Requirements: 7.2, 7.3, 7.8
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace ondeviceai {
+namespace bridge {
+
+/// Length of the longest prefix of `bytes` that does not end inside a
+/// multi-byte UTF-8 sequence.
+inline size_t completeUtf8Prefix(const std::string& bytes) {
+    size_t len = bytes.size();
+    size_t i = len;
+    // Walk back over at most 3 continuation bytes to the lead byte
+    while (i > 0 && len - i < 4) {
+        unsigned char c = static_cast<unsigned char>(bytes[i - 1]);
+        if ((c & 0xC0) != 0x80) {
+            size_t needed = (c & 0x80) == 0x00 ? 1
+                          : (c & 0xE0) == 0xC0 ? 2
+                          : (c & 0xF0) == 0xE0 ? 3
+                          : (c & 0xF8) == 0xF0 ? 4 : 1;
+            return (len - (i - 1) >= needed) ? len : i - 1;
+        }
+        --i;
+    }
+    return len;
+}
+
+} // namespace bridge
+} // namespace ondeviceai
@@ -0,0 +1,318 @@
+// dart:ffi bindings for the OnDeviceAI C ABI (src/ondeviceai_c.h).
+//
+// Results arrive on ReceivePorts as external typed data owned by native
+// code, so token text and PCM are never copied into the Dart heap.
+//
+// Requirements: 7.3, 7.8
+
+import 'dart:async';
+import 'dart:convert';
+import 'dart:ffi';
+import 'dart:io';
+import 'dart:isolate';
+import 'dart:typed_data';
+
+import 'package:ffi/ffi.dart';
+
+// ---------------------------------------------------------------------------
+// Native structs
+// ---------------------------------------------------------------------------
+
+final class NativeGenerationConfig extends Struct {
+  @Float()
+  external double temperature;
+
+  @Float()
+  external double topP;
+
+  @Int32()
+  external int maxTokens;
+}
+
+final class NativeSynthesisConfig extends Struct {
+  @Float()
+  external double speed;
+
+  @Float()
+  external double pitch;
+}
+
+// ---------------------------------------------------------------------------
+// Library loading
+// ---------------------------------------------------------------------------
+
+DynamicLibrary _openLibrary() {
+  if (Platform.isIOS || Platform.isMacOS) return DynamicLibrary.process();
+  if (Platform.isWindows) return DynamicLibrary.open('ondeviceai_ffi.dll');
+  return DynamicLibrary.open('libondeviceai_ffi.so');
+}
+
+/// Raw bindings. Prefer [OnDeviceAINative] which handles ports and errors.
+class OnDeviceAIBindings {
+  OnDeviceAIBindings(DynamicLibrary lib)
+      : initDartApi = lib.lookupFunction<Int32 Function(Pointer<Void>),
+            int Function(Pointer<Void>)>('odai_init_dart_api'),
+        initialize = lib.lookupFunction<
+            Int32 Function(Pointer<Utf8>, Int32, Int64),
+            int Function(Pointer<Utf8>, int, int)>('odai_initialize'),
+        shutdown = lib.lookupFunction<Void Function(), void Function()>(
+            'odai_shutdown'),
+        setThreadCount = lib.lookupFunction<Int32 Function(Int32),
+            int Function(int)>('odai_set_thread_count'),
+        lastErrorMessage = lib.lookupFunction<Pointer<Utf8> Function(),
+            Pointer<Utf8> Function()>('odai_last_error_message'),
+        llmLoadModel = lib.lookupFunction<
+            Int32 Function(Pointer<Utf8>, Pointer<Int64>),
+            int Function(Pointer<Utf8>, Pointer<Int64>)>('odai_llm_load_model'),
+        llmUnloadModel = lib.lookupFunction<Int32 Function(Int64),
+            int Function(int)>('odai_llm_unload_model'),
+        llmGenerateStreaming = lib.lookupFunction<
+            Int32 Function(Int64, Pointer<Utf8>, Pointer<NativeGenerationConfig>,
+                Int32, Int64),
+            int Function(int, Pointer<Utf8>, Pointer<NativeGenerationConfig>,
+                int, int)>('odai_llm_generate_streaming'),
+        sttLoadModel = lib.lookupFunction<
+            Int32 Function(Pointer<Utf8>, Pointer<Int64>),
+            int Function(Pointer<Utf8>, Pointer<Int64>)>('odai_stt_load_model'),
+        sttUnloadModel = lib.lookupFunction<Int32 Function(Int64),
+            int Function(int)>('odai_stt_unload_model'),
+        sttTranscribe = lib.lookupFunction<
+            Int32 Function(Int64, Pointer<Float>, Size, Int32, Int64),
+            int Function(int, Pointer<Float>, int, int, int)>(
+            'odai_stt_transcribe'),
+        ttsLoadModel = lib.lookupFunction<
+            Int32 Function(Pointer<Utf8>, Pointer<Int64>),
+            int Function(Pointer<Utf8>, Pointer<Int64>)>('odai_tts_load_model'),
+        ttsUnloadModel = lib.lookupFunction<Int32 Function(Int64),
+            int Function(int)>('odai_tts_unload_model'),
+        ttsSynthesize = lib.lookupFunction<
+            Int32 Function(
+                Int64, Pointer<Utf8>, Pointer<NativeSynthesisConfig>, Int64),
+            int Function(int, Pointer<Utf8>, Pointer<NativeSynthesisConfig>,
+                int)>('odai_tts_synthesize'),
+        audioBufferAlloc = lib.lookupFunction<Pointer<Float> Function(Size),
+            Pointer<Float> Function(int)>('odai_audio_buffer_alloc'),
+        audioBufferFree = lib.lookupFunction<Void Function(Pointer<Float>),
+            void Function(Pointer<Float>)>('odai_audio_buffer_free');
+
+  final int Function(Pointer<Void>) initDartApi;
+  final int Function(Pointer<Utf8>, int, int) initialize;
+  final void Function() shutdown;
+  final int Function(int) setThreadCount;
+  final Pointer<Utf8> Function() lastErrorMessage;
+  final int Function(Pointer<Utf8>, Pointer<Int64>) llmLoadModel;
+  final int Function(int) llmUnloadModel;
+  final int Function(
+          int, Pointer<Utf8>, Pointer<NativeGenerationConfig>, int, int)
+      llmGenerateStreaming;
+  final int Function(Pointer<Utf8>, Pointer<Int64>) sttLoadModel;
+  final int Function(int) sttUnloadModel;
+  final int Function(int, Pointer<Float>, int, int, int) sttTranscribe;
+  final int Function(Pointer<Utf8>, Pointer<Int64>) ttsLoadModel;
+  final int Function(int) ttsUnloadModel;
+  final int Function(int, Pointer<Utf8>, Pointer<NativeSynthesisConfig>, int)
+      ttsSynthesize;
+  final Pointer<Float> Function(int) audioBufferAlloc;
+  final void Function(Pointer<Float>) audioBufferFree;
+}
+
+// ---------------------------------------------------------------------------
+// Native audio buffer
+// ---------------------------------------------------------------------------
+
+/// PCM storage allocated by native code. Fill [samples] in place and pass
+/// the buffer to [OnDeviceAINative.transcribe] without any marshalling copy.
+class NativeAudioBuffer {
+  NativeAudioBuffer._(this._bindings, this.pointer, this.length)
+      : samples = pointer.asTypedList(length);
+
+  final OnDeviceAIBindings _bindings;
+  final Pointer<Float> pointer;
+  final int length;
+  final Float32List samples;
+
+  void free() => _bindings.audioBufferFree(pointer);
+}
+
+/// Synthesized PCM; [samples] is backed by native memory released by GC.
+class NativeAudio {
+  const NativeAudio(this.samples, this.sampleRate);
+
+  final Float32List samples;
+  final int sampleRate;
+}
+
+/// Thrown when a C ABI call reports a failure.
+class NativeCallException implements Exception {
+  const NativeCallException(this.code, this.message);
+
+  final int code;
+  final String message;
+
+  @override
+  String toString() => 'NativeCallException($code): $message';
+}
+
+// ---------------------------------------------------------------------------
+// High-level wrapper
+// ---------------------------------------------------------------------------
+
+class OnDeviceAINative {
+  OnDeviceAINative._(this._bindings) {
+    _check(_bindings.initDartApi(NativeApi.initializeApiDLData));
+  }
+
+  static OnDeviceAINative? _instance;
+
+  static OnDeviceAINative get instance =>
+      _instance ??= OnDeviceAINative._(OnDeviceAIBindings(_openLibrary()));
+
+  final OnDeviceAIBindings _bindings;
+
+  void _check(int status) {
+    if (status != 0) {
+      throw NativeCallException(
+          status, _bindings.lastErrorMessage().toDartString());
+    }
+  }
+
+  int _loadModel(
+      int Function(Pointer<Utf8>, Pointer<Int64>) load, String path) {
+    return using((arena) {
+      final out = arena<Int64>();
+      _check(load(path.toNativeUtf8(allocator: arena), out));
+      return out.value;
+    });
+  }
+
+  void initialize(
+      {required String modelDirectory,
+      required int threadCount,
+      required int memoryLimitBytes}) {
+    using((arena) => _check(_bindings.initialize(
+        modelDirectory.toNativeUtf8(allocator: arena),
+        threadCount,
+        memoryLimitBytes)));
+  }
+
+  void shutdown() => _bindings.shutdown();
+
+  void setThreadCount(int count) => _check(_bindings.setThreadCount(count));
+
+  // LLM ---------------------------------------------------------------------
+
+  int llmLoadModel(String path) => _loadModel(_bindings.llmLoadModel, path);
+
+  void llmUnloadModel(int handle) => _check(_bindings.llmUnloadModel(handle));
+
+  /// Stream generated text, [batchTokens] tokens per native post.
+  /// Cancelling the subscription closes the port, which stops generation.
+  Stream<String> generateStream(int handle, String prompt,
+      {double temperature = 0.7,
+      double topP = 0.9,
+      int maxTokens = 512,
+      int batchTokens = 8}) {
+    final port = ReceivePort();
+    final controller = StreamController<String>(onCancel: port.close);
+
+    port.listen((message) {
+      if (message is Uint8List) {
+        controller.add(utf8.decode(message));
+      } else if (message is String) {
+        controller.addError(NativeCallException(-1, message));
+        port.close();
+        controller.close();
+      } else {
+        port.close();
+        controller.close();
+      }
+    });
+
+    try {
+      using((arena) {
+        final config = arena<NativeGenerationConfig>()
+          ..ref.temperature = temperature
+          ..ref.topP = topP
+          ..ref.maxTokens = maxTokens;
+        _check(_bindings.llmGenerateStreaming(
+            handle,
+            prompt.toNativeUtf8(allocator: arena),
+            config,
+            batchTokens,
+            port.sendPort.nativePort));
+      });
+    } catch (e) {
+      port.close();
+      controller
+        ..addError(e)
+        ..close();
+    }
+    return controller.stream;
+  }
+
+  // STT ---------------------------------------------------------------------
+
+  int sttLoadModel(String path) => _loadModel(_bindings.sttLoadModel, path);
+
+  void sttUnloadModel(int handle) => _check(_bindings.sttUnloadModel(handle));
+
+  NativeAudioBuffer allocateAudio(int sampleCount) => NativeAudioBuffer._(
+      _bindings, _bindings.audioBufferAlloc(sampleCount), sampleCount);
+
+  /// Transcribe [audio]; the buffer may be reused once this returns.
+  Future<String> transcribe(int handle, NativeAudioBuffer audio,
+      {int sampleCount = -1, int sampleRate = 16000}) {
+    final count = sampleCount < 0 ? audio.length : sampleCount;
+    return _request(
+        (port) => _bindings.sttTranscribe(
+            handle, audio.pointer, count, sampleRate, port),
+        (message) => utf8.decode(message as Uint8List));
+  }
+
+  // TTS ---------------------------------------------------------------------
+
+  int ttsLoadModel(String path) => _loadModel(_bindings.ttsLoadModel, path);
+
+  void ttsUnloadModel(int handle) => _check(_bindings.ttsUnloadModel(handle));
+
+  Future<NativeAudio> synthesize(int handle, String text,
+      {double speed = 1.0, double pitch = 1.0}) {
+    return using((arena) {
+      final config = arena<NativeSynthesisConfig>()
+        ..ref.speed = speed
+        ..ref.pitch = pitch;
+      final nativeText = text.toNativeUtf8(allocator: arena);
+      return _request(
+          (port) => _bindings.ttsSynthesize(handle, nativeText, config, port),
+          (message) {
+        final parts = message as List;
+        return NativeAudio(parts[0] as Float32List, parts[1] as int);
+      });
+    });
+  }
+
+  /// Issue a native call that answers with a single port message;
+  /// a String message is an error.
+  Future<T> _request<T>(
+      int Function(int port) call, T Function(Object? message) decode) {
+    final port = ReceivePort();
+    final completer = Completer<T>();
+
+    port.listen((message) {
+      port.close();
+      if (message is String) {
+        completer.completeError(NativeCallException(-1, message));
+      } else {
+        completer.complete(decode(message));
+      }
+    });
+
+    final status = call(port.sendPort.nativePort);
+    if (status != 0) {
+      port.close();
+      completer.completeError(NativeCallException(
+          status, _bindings.lastErrorMessage().toDartString()));
+    }
+    return completer.future;
+  }
+}
@@ -0,0 +1,449 @@
+/**
+ * ondeviceai_c.cpp
+ * C ABI implementation — wraps SDKManager and posts results to Dart ports.
+ *
+ * Requirements: 7.3, 7.8
+ */
+
+#include "ondeviceai_c.h"
+
+#include "dart_api_dl.h"
+
+#include "ondeviceai/sdk_manager.hpp"
+#include "ondeviceai/llm_engine.hpp"
+#include "ondeviceai/stt_engine.hpp"
+#include "ondeviceai/tts_engine.hpp"
+#include "ondeviceai/types.hpp"
+
+#include "../../common/stream_completion.h"
+#include "../../common/utf8_prefix.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace ondeviceai;
+
+namespace {
+
+thread_local std::string t_last_error;
+
+int32_t setError(int32_t code, std::string message) {
+    t_last_error = std::move(message);
+    return code;
+}
+
+int32_t setError(const Error& error) {
+    return setError(static_cast<int32_t>(error.code), error.message);
+}
+
+/// Error code for failures detected in the ABI layer itself
+constexpr int32_t kInvalidState = -2;
+
+SDKManager* requireSDK() {
+    auto* mgr = SDKManager::getInstance();
+    if (!mgr) setError(kInvalidState, "SDK not initialized");
+    return mgr;
+}
+
+// ---------------------------------------------------------------------------
+// Background work tracking
+// ---------------------------------------------------------------------------
+
+/// Counts the detached workers that still use the SDK, so odai_shutdown()
+/// can wait for them instead of destroying the engines underneath them.
+struct WorkTracker {
+    std::mutex mutex;
+    std::condition_variable idle;
+    int outstanding = 0;
+    bool shutting_down = false;
+};
+
+WorkTracker& workTracker() {
+    static WorkTracker tracker;
+    return tracker;
+}
+
+/// Reserve a slot for one background worker. Fails once shutdown has begun.
+bool beginWork() {
+    auto& tracker = workTracker();
+    std::lock_guard<std::mutex> lock(tracker.mutex);
+    if (tracker.shutting_down) return false;
+    ++tracker.outstanding;
+    return true;
+}
+
+/// Take one more slot for work that outlives the caller's own, such as a
+/// stream's queued token callbacks. The caller already holds a slot, so
+/// shutdown cannot have completed in between.
+void retainWork() {
+    auto& tracker = workTracker();
+    std::lock_guard<std::mutex> lock(tracker.mutex);
+    ++tracker.outstanding;
+}
+
+/// Releases a slot taken by beginWork() or retainWork()
+struct WorkScope {
+    WorkScope() = default;
+    WorkScope(const WorkScope&) = delete;
+    WorkScope& operator=(const WorkScope&) = delete;
+    ~WorkScope() {
+        auto& tracker = workTracker();
+        std::lock_guard<std::mutex> lock(tracker.mutex);
+        if (--tracker.outstanding == 0) tracker.idle.notify_all();
+    }
+};
+
+/// Resolve the SDK for a new background worker and reserve its slot
+SDKManager* requireSDKForWork() {
+    if (!requireSDK()) return nullptr;
+    if (!beginWork()) {
+        setError(kInvalidState, "SDK is shutting down");
+        return nullptr;
+    }
+    return SDKManager::getInstance();
+}
+
+/// Start a detached worker that holds a work slot for its whole lifetime
+template <typename Fn>
+void spawnWorker(Fn fn) {
+    std::thread([fn = std::move(fn)]() mutable {
+        WorkScope scope;
+        fn();
+    }).detach();
+}
+
+// ---------------------------------------------------------------------------
+// Dart port helpers
+// ---------------------------------------------------------------------------
+
+void freeBytes(void* /*isolate_callback_data*/, void* peer) {
+    delete[] static_cast<uint8_t*>(peer);
+}
+
+void freeSamples(void* /*isolate_callback_data*/, void* peer) {
+    delete static_cast<std::vector<float>*>(peer);
+}
+
+/// Post UTF-8 bytes as an external Uint8List. Ownership moves to Dart on
+/// success; returns false (and frees) when the port is closed.
+bool postBytes(Dart_Port port, const char* data, size_t length) {
+    auto* bytes = new uint8_t[length];
+    std::memcpy(bytes, data, length);
+
+    Dart_CObject obj;
+    obj.type = Dart_CObject_kExternalTypedData;
+    obj.value.as_external_typed_data.type     = Dart_TypedData_kUint8;
+    obj.value.as_external_typed_data.length   = static_cast<intptr_t>(length);
+    obj.value.as_external_typed_data.data     = bytes;
+    obj.value.as_external_typed_data.peer     = bytes;
+    obj.value.as_external_typed_data.callback = freeBytes;
+
+    if (!Dart_PostCObject_DL(port, &obj)) {
+        delete[] bytes;
+        return false;
+    }
+    return true;
+}
+
+bool postString(Dart_Port port, const std::string& message) {
+    Dart_CObject obj;
+    obj.type = Dart_CObject_kString;
+    obj.value.as_string = const_cast<char*>(message.c_str());
+    return Dart_PostCObject_DL(port, &obj);
+}
+
+bool postNull(Dart_Port port) {
+    Dart_CObject obj;
+    obj.type = Dart_CObject_kNull;
+    return Dart_PostCObject_DL(port, &obj);
+}
+
+/// Post [Float32List, sampleRate]. The vector is handed to Dart as the
+/// backing store of the list, so the samples are never copied.
+bool postSamples(Dart_Port port, std::vector<float> samples, int sample_rate) {
+    auto* owned = new std::vector<float>(std::move(samples));
+
+    Dart_CObject pcm;
+    pcm.type = Dart_CObject_kExternalTypedData;
+    pcm.value.as_external_typed_data.type     = Dart_TypedData_kFloat32;
+    pcm.value.as_external_typed_data.length   = static_cast<intptr_t>(owned->size());
+    pcm.value.as_external_typed_data.data     = reinterpret_cast<uint8_t*>(owned->data());
+    pcm.value.as_external_typed_data.peer     = owned;
+    pcm.value.as_external_typed_data.callback = freeSamples;
+
+    Dart_CObject rate;
+    rate.type = Dart_CObject_kInt64;
+    rate.value.as_int64 = sample_rate;
+
+    Dart_CObject* values[] = {&pcm, &rate};
+    Dart_CObject array;
+    array.type = Dart_CObject_kArray;
+    array.value.as_array.length = 2;
+    array.value.as_array.values = values;
+
+    if (!Dart_PostCObject_DL(port, &array)) {
+        delete owned;
+        return false;
+    }
+    return true;
+}
+
+using bridge::completeUtf8Prefix;
+
+int32_t loadModel(Result<ModelHandle> result, odai_handle_t* out_handle) {
+    if (result.isError()) return setError(result.error());
+    if (out_handle) *out_handle = static_cast<odai_handle_t>(result.value());
+    return ODAI_OK;
+}
+
+} // namespace
+
+extern "C" {
+
+// ---------------------------------------------------------------------------
+// Setup
+// ---------------------------------------------------------------------------
+
+int32_t odai_init_dart_api(void* initialize_api_dl_data) {
+    if (Dart_InitializeApiDL(initialize_api_dl_data) != 0) {
+        return setError(kInvalidState, "Incompatible Dart API version");
+    }
+    return ODAI_OK;
+}
+
+int32_t odai_initialize(const char* model_directory, int32_t thread_count, int64_t memory_limit_bytes) {
+    SDKConfig config;
+    config.model_directory = model_directory ? model_directory : "";
+    config.thread_count    = static_cast<int>(thread_count);
+    config.memory_limit    = static_cast<size_t>(memory_limit_bytes);
+    config.log_level       = LogLevel::Info;
+    // One callback thread keeps streamed tokens in generation order
+    config.callback_thread_count = 1;
+
+    auto result = SDKManager::initialize(config);
+    if (result.isError()) return setError(result.error());
+    return ODAI_OK;
+}
+
+void odai_shutdown(void) {
+    auto& tracker = workTracker();
+    {
+        // Refuse new work, then wait for running workers to finish
+        std::unique_lock<std::mutex> lock(tracker.mutex);
+        tracker.shutting_down = true;
+        tracker.idle.wait(lock, [&] { return tracker.outstanding == 0; });
+    }
+    SDKManager::shutdown();
+    std::lock_guard<std::mutex> lock(tracker.mutex);
+    tracker.shutting_down = false;
+}
+
+int32_t odai_set_thread_count(int32_t count) {
+    auto* mgr = requireSDK();
+    if (!mgr) return kInvalidState;
+    mgr->setThreadCount(static_cast<int>(count));
+    return ODAI_OK;
+}
+
+const char* odai_last_error_message(void) {
+    return t_last_error.c_str();
+}
+
+// ---------------------------------------------------------------------------
+// LLM
+// ---------------------------------------------------------------------------
+
+int32_t odai_llm_load_model(const char* path, odai_handle_t* out_handle) {
+    auto* mgr = requireSDK();
+    if (!mgr) return kInvalidState;
+    return loadModel(mgr->getLLMEngine()->loadModel(path ? path : ""), out_handle);
+}
+
+int32_t odai_llm_unload_model(odai_handle_t handle) {
+    auto* mgr = requireSDK();
+    if (!mgr) return kInvalidState;
+    auto result = mgr->getLLMEngine()->unloadModel(static_cast<ModelHandle>(handle));
+    if (result.isError()) return setError(result.error());
+    return ODAI_OK;
+}
+
+int32_t odai_llm_generate_streaming(odai_handle_t handle, const char* prompt,
+                                    const odai_generation_config* config,
+                                    int32_t batch_tokens, odai_port_t port) {
+    if (!requireSDKForWork()) return kInvalidState;
+
+    GenerationConfig gCfg;
+    if (config) {
+        gCfg.temperature = config->temperature;
+        gCfg.top_p       = config->top_p;
+        gCfg.max_tokens  = static_cast<int>(config->max_tokens);
+    }
+    const int batch = std::max<int32_t>(1, batch_tokens);
+
+    spawnWorker([handle, prompt = std::string(prompt ? prompt : ""), gCfg, batch, port]() {
+        // Tokens arrive on dispatcher threads, so the batch lives on the
+        // heap behind a mutex rather than on this thread's stack.
+        struct Stream {
+            std::mutex mutex;
+            std::string pending;
+            int pending_tokens = 0;
+            bool port_open = true;
+            bool failed = false;
+            std::string error;
+
+            // Caller holds `mutex`
+            void flush(Dart_Port target, bool force) {
+                size_t n = force ? pending.size() : completeUtf8Prefix(pending);
+                if (n == 0 || !port_open) return;
+                port_open = postBytes(target, pending.data(), n);
+                pending.erase(0, n);
+                pending_tokens = 0;
+            }
+        };
+        auto stream = std::make_shared<Stream>();
+
+        // The terminal message goes out once this stream's last queued
+        // token callback is gone, not when the whole dispatcher drains. Its
+        // work slot keeps odai_shutdown() waiting for those callbacks too.
+        retainWork();
+        auto completion = std::make_shared<bridge::StreamCompletion>([stream, port]() {
+            WorkScope scope;
+            std::lock_guard<std::mutex> lock(stream->mutex);
+            stream->flush(port, true);
+            if (!stream->port_open) return;
+            if (stream->failed) {
+                postString(port, stream->error);
+            } else {
+                postNull(port);
+            }
+        });
+
+        auto* mgr = SDKManager::getInstance();
+        auto result = mgr->getLLMEngine()->generateStreaming(
+            static_cast<ModelHandle>(handle), prompt,
+            // `completion` is only held: each queued copy keeps it alive
+            [stream, batch, port, completion](const std::string& token) {
+                std::lock_guard<std::mutex> lock(stream->mutex);
+                if (!stream->port_open) return;
+                stream->pending += token;
+                if (++stream->pending_tokens >= batch) stream->flush(port, false);
+            },
+            gCfg);
+
+        if (result.isError()) {
+            std::lock_guard<std::mutex> lock(stream->mutex);
+            stream->failed = true;
+            stream->error = result.error().message;
+        }
+        completion.reset();
+    });
+
+    return ODAI_OK;
+}
+
+// ---------------------------------------------------------------------------
+// STT
+// ---------------------------------------------------------------------------
+
+int32_t odai_stt_load_model(const char* path, odai_handle_t* out_handle) {
+    auto* mgr = requireSDK();
+    if (!mgr) return kInvalidState;
+    return loadModel(mgr->getSTTEngine()->loadModel(path ? path : ""), out_handle);
+}
+
+int32_t odai_stt_unload_model(odai_handle_t handle) {
+    auto* mgr = requireSDK();
+    if (!mgr) return kInvalidState;
+    auto result = mgr->getSTTEngine()->unloadModel(static_cast<ModelHandle>(handle));
+    if (result.isError()) return setError(result.error());
+    return ODAI_OK;
+}
+
+int32_t odai_stt_transcribe(odai_handle_t handle, const float* samples, size_t sample_count,
+                            int32_t sample_rate, odai_port_t port) {
+    if (!requireSDKForWork()) return kInvalidState;
+
+    // The caller's buffer is only borrowed for this call
+    AudioData audio;
+    if (samples && sample_count > 0) {
+        audio.samples.assign(samples, samples + sample_count);
+    }
+    audio.sample_rate = static_cast<int>(sample_rate);
+    audio.channels    = 1;
+
+    spawnWorker([handle, audio = std::move(audio), port]() {
+        TranscriptionConfig tCfg;
+        auto result = SDKManager::getInstance()->getSTTEngine()->transcribe(static_cast<ModelHandle>(handle), audio, tCfg);
+        if (result.isError()) {
+            postString(port, result.error().message);
+            return;
+        }
+        const std::string& text = result.value().text;
+        postBytes(port, text.data(), text.size());
+    });
+
+    return ODAI_OK;
+}
+
+// ---------------------------------------------------------------------------
+// TTS
+// ---------------------------------------------------------------------------
+
+int32_t odai_tts_load_model(const char* path, odai_handle_t* out_handle) {
+    auto* mgr = requireSDK();
+    if (!mgr) return kInvalidState;
+    return loadModel(mgr->getTTSEngine()->loadModel(path ? path : ""), out_handle);
+}
+
+int32_t odai_tts_unload_model(odai_handle_t handle) {
+    auto* mgr = requireSDK();
+    if (!mgr) return kInvalidState;
+    auto result = mgr->getTTSEngine()->unloadModel(static_cast<ModelHandle>(handle));
+    if (result.isError()) return setError(result.error());
+    return ODAI_OK;
+}
+
+int32_t odai_tts_synthesize(odai_handle_t handle, const char* text,
+                            const odai_synthesis_config* config, odai_port_t port) {
+    if (!requireSDKForWork()) return kInvalidState;
+
+    SynthesisConfig sCfg;
+    if (config) {
+        sCfg.speed = config->speed;
+        sCfg.pitch = config->pitch;
+    }
+
+    spawnWorker([handle, text = std::string(text ? text : ""), sCfg, port]() {
+        auto result = SDKManager::getInstance()->getTTSEngine()->synthesize(static_cast<ModelHandle>(handle), text, sCfg);
+        if (result.isError()) {
+            postString(port, result.error().message);
+            return;
+        }
+        const int sample_rate = result.value().sample_rate;
+        postSamples(port, std::move(result.value().samples), sample_rate);
+    });
+
+    return ODAI_OK;
+}
+
+// ---------------------------------------------------------------------------
+// Native audio buffers
+// ---------------------------------------------------------------------------
+
+float* odai_audio_buffer_alloc(size_t sample_count) {
+    return static_cast<float*>(std::malloc(sample_count * sizeof(float)));
+}
+
+void odai_audio_buffer_free(float* buffer) {
+    std::free(buffer);
+}
+
+} // extern "C"
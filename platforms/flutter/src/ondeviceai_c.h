@@ -0,0 +1,147 @@
+/**
+ * ondeviceai_c.h
+ * Stable C ABI over the C++ core for dart:ffi and other FFI consumers.
+ *
+ * Conventions:
+ *  - Functions return ODAI_OK (0) or the core ErrorCode value; the message
+ *    of the last failure on the calling thread is read with
+ *    odai_last_error_message().
+ *  - Input buffers (strings, PCM) are borrowed: they only need to stay
+ *    valid for the duration of the call.
+ *  - Asynchronous results are posted to a Dart SendPort as external typed
+ *    data (Uint8List for UTF-8 text, Float32List for PCM) whose storage is
+ *    owned by native code and released by a Dart finalizer, so no copy is
+ *    made on the Dart side.
+ *
+ * Requirements: 7.3, 7.8
+ */
+
+#ifndef ONDEVICEAI_C_H
+#define ONDEVICEAI_C_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(_WIN32)
+#define ODAI_API __declspec(dllexport)
+#else
+#define ODAI_API __attribute__((visibility("default"))) __attribute__((used))
+#endif
+
+#define ODAI_OK 0
+
+typedef int64_t odai_handle_t;
+typedef int64_t odai_port_t;
+
+typedef struct {
+    float temperature;
+    float top_p;
+    int32_t max_tokens;
+} odai_generation_config;
+
+typedef struct {
+    float speed;
+    float pitch;
+} odai_synthesis_config;
+
+// ---------------------------------------------------------------------------
+// Setup
+// ---------------------------------------------------------------------------
+
+/// Initialize the Dart API DL; pass NativeApi.initializeApiDLData.
+ODAI_API int32_t odai_init_dart_api(void* initialize_api_dl_data);
+
+ODAI_API int32_t odai_initialize(const char* model_directory,
+                                 int32_t thread_count,
+                                 int64_t memory_limit_bytes);
+
+/**
+ * Shut the SDK down. Blocks until every background generate, transcribe
+ * and synthesize call has posted its result; calls that start while
+ * shutdown is in progress fail with -2.
+ */
+ODAI_API void odai_shutdown(void);
+
+ODAI_API int32_t odai_set_thread_count(int32_t count);
+
+/// Message of the last failed call on this thread ("" if none).
+/// Valid until the next call on the same thread.
+ODAI_API const char* odai_last_error_message(void);
+
+// ---------------------------------------------------------------------------
+// LLM
+// ---------------------------------------------------------------------------
+
+ODAI_API int32_t odai_llm_load_model(const char* path, odai_handle_t* out_handle);
+ODAI_API int32_t odai_llm_unload_model(odai_handle_t handle);
+
+/**
+ * Start streaming generation on a background thread.
+ *
+ * Posts to `port`:
+ *  - Uint8List : UTF-8 text of up to `batch_tokens` tokens (always whole code points)
+ *  - null      : generation finished
+ *  - String    : generation failed, with the error message
+ *
+ * Tokens are dropped once the port is closed; the running decode still
+ * completes. `config` may be NULL.
+ */
+ODAI_API int32_t odai_llm_generate_streaming(odai_handle_t handle,
+                                             const char* prompt,
+                                             const odai_generation_config* config,
+                                             int32_t batch_tokens,
+                                             odai_port_t port);
+
+// ---------------------------------------------------------------------------
+// STT
+// ---------------------------------------------------------------------------
+
+ODAI_API int32_t odai_stt_load_model(const char* path, odai_handle_t* out_handle);
+ODAI_API int32_t odai_stt_unload_model(odai_handle_t handle);
+
+/**
+ * Transcribe mono Float32 PCM on a background thread. `samples` is
+ * borrowed for the duration of the call only.
+ *
+ * Posts a Uint8List (UTF-8 transcript) or a String error to `port`.
+ */
+ODAI_API int32_t odai_stt_transcribe(odai_handle_t handle,
+                                     const float* samples,
+                                     size_t sample_count,
+                                     int32_t sample_rate,
+                                     odai_port_t port);
+
+// ---------------------------------------------------------------------------
+// TTS
+// ---------------------------------------------------------------------------
+
+ODAI_API int32_t odai_tts_load_model(const char* path, odai_handle_t* out_handle);
+ODAI_API int32_t odai_tts_unload_model(odai_handle_t handle);
+
+/**
+ * Synthesize on a background thread. `config` may be NULL.
+ *
+ * Posts [Float32List samples, int sampleRate] or a String error to `port`.
+ */
+ODAI_API int32_t odai_tts_synthesize(odai_handle_t handle,
+                                     const char* text,
+                                     const odai_synthesis_config* config,
+                                     odai_port_t port);
+
+// ---------------------------------------------------------------------------
+// Native audio buffers
+// ---------------------------------------------------------------------------
+
+/// Allocate a PCM buffer Dart can fill in place via Pointer<Float>.asTypedList.
+ODAI_API float* odai_audio_buffer_alloc(size_t sample_count);
+ODAI_API void odai_audio_buffer_free(float* buffer);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // ONDEVICEAI_C_H
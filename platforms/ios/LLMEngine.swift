@@ -126,28 +126,111 @@ public class LLMEngine {
                     return
                 }
                 
+                // Resumes once this call's last token callback has run
+                var completion: StreamCompletion? = StreamCompletion { outcome in
+                    continuation.resume(with: outcome)
+                }
+                
                 var error: NSError?
                 let success = self.objcEngine.generateStreaming(
                     model.value,
                     prompt: prompt,
-                    callback: { token in
-                        onToken(token)
+                    callback: { [completion] token in
+                        withExtendedLifetime(completion) {
+                            onToken(token)
+                        }
                     },
                     config: config.toObjC(),
                     error: &error
                 )
                 
-                if let error = error {
-                    continuation.resume(throwing: SDKError.from(error))
-                } else if success {
-                    continuation.resume()
-                } else {
-                    continuation.resume(throwing: SDKError.unknown("Failed to generate streaming text"))
+                completion?.resolve(Self.streamingOutcome(success: success, error: error))
+                completion = nil
+            }
+        }
+    }
+    
+    /// Generate text as an `AsyncThrowingStream` of coalesced token batches
+    ///
+    /// Tokens from the native callback are buffered and yielded as one string per batch,
+    /// so consumers such as a SwiftUI chat view do one actor hop per batch instead of
+    /// one per token.
+    ///
+    /// Cancelling the consuming task (or dropping the stream) terminates it at once and
+    /// discards further tokens. The core has no way to abort a running decode, so native
+    /// generation still runs to completion, bounded by `config.maxTokens`.
+    ///
+    /// - Parameters:
+    ///   - model: Model handle
+    ///   - prompt: Input prompt
+    ///   - config: Generation configuration (defaults to standard configuration)
+    ///   - batching: Token coalescing policy (defaults to flushing every 16 ms or 16 tokens)
+    /// - Returns: Stream of text chunks; finishes when generation completes or throws on failure
+    public func generateStream(
+        model: ModelHandle,
+        prompt: String,
+        config: GenerationConfig = .default,
+        batching: TokenBatching = .default
+    ) -> AsyncThrowingStream<String, Error> {
+        return AsyncThrowingStream { continuation in
+            let cancellation = StreamCancellation()
+            let batcher = TokenBatcher(batching: batching) { chunk in
+                continuation.yield(chunk)
+            }
+            
+            continuation.onTermination = { termination in
+                if case .cancelled = termination {
+                    cancellation.cancel()
                 }
             }
+            
+            DispatchQueue.global(qos: .userInitiated).async { [weak self] in
+                guard let self = self else {
+                    continuation.finish(throwing: SDKError.invalidState("LLMEngine deallocated"))
+                    return
+                }
+                
+                // Asynchronous dispatch may still hold tokens. The stream finishes
+                // once this stream's last token callback has reached the batcher,
+                // without waiting on callbacks of other streams.
+                var completion: StreamCompletion? = StreamCompletion { outcome in
+                    if cancellation.isCancelled { return }
+                    batcher.finish()
+                    switch outcome {
+                    case .success:
+                        continuation.finish()
+                    case .failure(let error):
+                        continuation.finish(throwing: error)
+                    }
+                }
+                
+                var error: NSError?
+                let success = self.objcEngine.generateStreaming(
+                    model.value,
+                    prompt: prompt,
+                    callback: { [completion] token in
+                        withExtendedLifetime(completion) {
+                            guard !cancellation.isCancelled else { return }
+                            batcher.append(token)
+                        }
+                    },
+                    config: config.toObjC(),
+                    error: &error
+                )
+                
+                completion?.resolve(Self.streamingOutcome(success: success, error: error))
+                completion = nil
+            }
         }
     }
     
+    private static func streamingOutcome(success: Bool, error: NSError?) -> Result<Void, Error> {
+        if let error = error {
+            return .failure(SDKError.from(error))
+        }
+        return success ? .success(()) : .failure(SDKError.unknown("Failed to generate streaming text"))
+    }
+    
     // MARK: - Context Management
     
     /// Clear conversation context
@@ -207,3 +290,113 @@ public class LLMEngine {
         return text
     }
 }
+
+// MARK: - Stream Cancellation
+
+/// Cancellation flag shared between a stream's termination handler and the
+/// native token callback, which run on different threads
+internal final class StreamCancellation {
+    
+    private let lock = NSLock()
+    private var cancelled = false
+    
+    var isCancelled: Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        return cancelled
+    }
+    
+    func cancel() {
+        lock.lock()
+        cancelled = true
+        lock.unlock()
+    }
+}
+
+// MARK: - Stream Completion
+
+/// Per-stream fence for token callbacks delivered by the asynchronous dispatcher
+///
+/// The native token callback captures the completion, and the bridge keeps that
+/// callback alive in every dispatched token until it has run. The last release
+/// therefore happens after this stream's final token, and `deinit` reports the
+/// outcome that the caller resolved once `generateStreaming` returned.
+internal final class StreamCompletion {
+    
+    private let lock = NSLock()
+    private var outcome: Result<Void, Error> = .success(())
+    private let onDrained: (Result<Void, Error>) -> Void
+    
+    init(onDrained: @escaping (Result<Void, Error>) -> Void) {
+        self.onDrained = onDrained
+    }
+    
+    func resolve(_ outcome: Result<Void, Error>) {
+        lock.lock()
+        self.outcome = outcome
+        lock.unlock()
+    }
+    
+    deinit {
+        lock.lock()
+        let outcome = self.outcome
+        lock.unlock()
+        onDrained(outcome)
+    }
+}
+
+// MARK: - Token Batching
+
+/// Coalesces streamed tokens and hands them to `deliver` in batches
+///
+/// A batch is flushed when it reaches `maxTokens`, or by a deadline scheduled
+/// `maxInterval` after its first token, so no token waits longer than that.
+internal final class TokenBatcher {
+    
+    private let batching: TokenBatching
+    private let deliver: (String) -> Void
+    private let queue = DispatchQueue(label: "com.ondeviceai.llm.tokenbatcher")
+    
+    private var pending = ""
+    private var pendingCount = 0
+    /// Incremented per flush so a stale deadline does not flush a newer batch
+    private var generation = 0
+    
+    init(batching: TokenBatching, deliver: @escaping (String) -> Void) {
+        self.batching = batching
+        self.deliver = deliver
+    }
+    
+    func append(_ token: String) {
+        queue.sync {
+            pending += token
+            pendingCount += 1
+            
+            if pendingCount >= batching.maxTokens || batching.maxInterval <= 0 {
+                flushLocked()
+            } else if pendingCount == 1 {
+                let scheduled = generation
+                queue.asyncAfter(deadline: .now() + batching.maxInterval) { [weak self] in
+                    guard let self = self, self.generation == scheduled else { return }
+                    self.flushLocked()
+                }
+            }
+        }
+    }
+    
+    /// Deliver any remaining tokens; call once generation has ended
+    func finish() {
+        queue.sync {
+            flushLocked()
+        }
+    }
+    
+    private func flushLocked() {
+        generation += 1
+        guard pendingCount > 0 else { return }
+        let chunk = pending
+        pending = ""
+        pendingCount = 0
+        deliver(chunk)
+    }
+}
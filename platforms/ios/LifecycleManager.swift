@@ -15,6 +15,7 @@ import Foundation
 /// - Background/foreground transitions
 /// - Automatic model unloading to free memory
 /// - Optional inference pausing when app is in background
+/// - Optional thermal-aware thread count adjustment
 public class LifecycleManager {
     
     // MARK: - Properties
@@ -31,11 +32,20 @@ public class LifecycleManager {
     /// Closure called when app enters foreground
     public var onEnterForeground: (() -> Void)?
     
+    /// Closure called when the adaptive performance governor changes the thread count
+    ///
+    /// Receives the thermal state that triggered the change and the thread count now in use.
+    public var onThermalAdjustment: ((ProcessInfo.ThermalState, Int) -> Void)?
+    
     // MARK: - Initialization
     
     internal init(objcLifecycleManager: ODAILifecycleManager, sdkManager: ODAISDKManager) {
         self.objcLifecycleManager = objcLifecycleManager
         self.sdkManager = sdkManager
+        
+        objcLifecycleManager.thermalAdjustmentHandler = { [weak self] state, threadCount in
+            self?.onThermalAdjustment?(state, threadCount)
+        }
     }
     
     // MARK: - Observation Control
@@ -80,6 +90,36 @@ public class LifecycleManager {
         return objcLifecycleManager.isPauseInferenceOnBackgroundEnabled()
     }
     
+    /// Enable or disable thermal-aware thread count adjustment
+    ///
+    /// While enabled and observing, the SDK thread count steps down from `baseThreadCount`
+    /// as `ProcessInfo.thermalState` rises, and back up as the device cools, keeping
+    /// latency steady in sustained voice sessions instead of hitting hard throttling.
+    ///
+    /// - Parameters:
+    ///   - enabled: true to adapt the thread count to thermal state
+    ///   - baseThreadCount: Thread count to use when the device is not throttled
+    public func setAdaptivePerformance(_ enabled: Bool, baseThreadCount: Int) {
+        objcLifecycleManager.setAdaptivePerformanceEnabled(enabled, baseThreadCount: baseThreadCount)
+    }
+    
+    /// Check if thermal-aware thread count adjustment is enabled
+    ///
+    /// - Returns: true if adaptive performance is enabled, false otherwise
+    public func isAdaptivePerformanceEnabled() -> Bool {
+        return objcLifecycleManager.isAdaptivePerformanceEnabled()
+    }
+    
+    /// Thread count the adaptive performance governor uses for a thermal state
+    ///
+    /// - Parameters:
+    ///   - thermalState: Device thermal state
+    ///   - baseThreadCount: Thread count used when the device is not throttled
+    /// - Returns: Thread count to apply (at least 1)
+    public static func threadCount(for thermalState: ProcessInfo.ThermalState, baseThreadCount: Int) -> Int {
+        return ODAILifecycleManager.threadCount(for: thermalState, baseThreadCount: baseThreadCount)
+    }
+    
     // MARK: - Memory Information
     
     /// Get current memory usage
@@ -158,6 +198,7 @@ public class LifecycleManager {
         return [
             "isObserving": objcLifecycleManager.isPauseInferenceOnBackgroundEnabled(), // Placeholder
             "pauseInferenceOnBackground": isPauseInferenceOnBackgroundEnabled(),
+            "adaptivePerformance": isAdaptivePerformanceEnabled(),
             "currentMemoryUsage": getCurrentMemoryUsage(),
             "memoryLimit": getMemoryLimit(),
             "isMemoryPressure": isMemoryPressure()
@@ -105,7 +105,31 @@ class LifecycleManagerTests: XCTestCase {
         XCTAssertFalse(lifecycleManager?.isPauseInferenceOnBackgroundEnabled() ?? false,
                       "Should be able to disable pause on background")
     }
-    
+
+    func testAdaptivePerformanceToggle() {
+        XCTAssertFalse(lifecycleManager?.isAdaptivePerformanceEnabled() ?? true,
+                      "Adaptive performance should be disabled by default")
+
+        lifecycleManager?.setAdaptivePerformance(true, baseThreadCount: 4)
+        XCTAssertTrue(lifecycleManager?.isAdaptivePerformanceEnabled() ?? false,
+                     "Should be able to enable adaptive performance")
+
+        lifecycleManager?.setAdaptivePerformance(false, baseThreadCount: 4)
+        XCTAssertFalse(lifecycleManager?.isAdaptivePerformanceEnabled() ?? true,
+                      "Should be able to disable adaptive performance")
+    }
+
+    func testThreadCountStepsDownWithThermalState() {
+        XCTAssertEqual(LifecycleManager.threadCount(for: .nominal, baseThreadCount: 8), 8)
+        XCTAssertEqual(LifecycleManager.threadCount(for: .fair, baseThreadCount: 8), 6)
+        XCTAssertEqual(LifecycleManager.threadCount(for: .serious, baseThreadCount: 8), 4)
+        XCTAssertEqual(LifecycleManager.threadCount(for: .critical, baseThreadCount: 8), 1)
+
+        // Never drops below one thread
+        XCTAssertEqual(LifecycleManager.threadCount(for: .serious, baseThreadCount: 1), 1)
+        XCTAssertEqual(LifecycleManager.threadCount(for: .nominal, baseThreadCount: 0), 1)
+    }
+
     // MARK: - Memory Information Tests
     
     func testGetCurrentMemoryUsage() {
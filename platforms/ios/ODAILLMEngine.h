@@ -57,7 +57,9 @@ NS_ASSUME_NONNULL_BEGIN
  * Generate text with streaming callbacks
  * @param handle Model handle
  * @param prompt Input prompt
- * @param callback Token callback (called for each generated token)
+ * @param callback Token callback (called for each generated token). Each
+ *        dispatched token retains the block until it has run, so its final
+ *        release marks the last token of this call.
  * @param config Generation configuration
  * @param error Error pointer for failures
  * @return YES on success, NO on error
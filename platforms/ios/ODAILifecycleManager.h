@@ -12,6 +12,14 @@ NS_ASSUME_NONNULL_BEGIN
 
 @class ODAISDKManager;
 
+/**
+ * Called after the adaptive performance governor changes the SDK thread count
+ * Invoked on the main queue
+ * @param thermalState The thermal state that triggered the adjustment
+ * @param threadCount The thread count now applied to the SDK
+ */
+typedef void (^ODAIThermalAdjustmentHandler)(NSProcessInfoThermalState thermalState, NSInteger threadCount);
+
 /**
  * Manages iOS-specific lifecycle events for the SDK
  * Handles memory warnings and background/foreground transitions
@@ -49,6 +57,37 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (BOOL)isPauseInferenceOnBackgroundEnabled;
 
+/**
+ * Enable or disable thermal-aware thread count adjustment
+ * While enabled, the SDK thread count follows the device thermal state,
+ * stepping down from baseThreadCount as the device heats up. Disabling
+ * restores the base thread count only if the governor had lowered it.
+ * @param enabled YES to adapt the thread count to thermal state
+ * @param baseThreadCount Thread count to use when the device is not throttled
+ */
+- (void)setAdaptivePerformanceEnabled:(BOOL)enabled baseThreadCount:(NSInteger)baseThreadCount;
+
+/**
+ * Check if thermal-aware thread count adjustment is enabled
+ * @return YES if enabled, NO otherwise
+ */
+- (BOOL)isAdaptivePerformanceEnabled;
+
+/**
+ * Handler invoked for every governor decision, for telemetry
+ */
+@property (atomic, copy, nullable) ODAIThermalAdjustmentHandler thermalAdjustmentHandler;
+
+/**
+ * Thread count the governor applies for a thermal state
+ * @param thermalState Current device thermal state
+ * @param baseThreadCount Thread count used when the device is not throttled
+ * @return Thread count to apply (at least 1)
+ */
++ (NSInteger)threadCountForThermalState:(NSProcessInfoThermalState)thermalState
+                        baseThreadCount:(NSInteger)baseThreadCount
+    NS_SWIFT_NAME(threadCount(for:baseThreadCount:));
+
 // Prevent direct instantiation without SDK manager
 - (instancetype)init NS_UNAVAILABLE;
 + (instancetype)new NS_UNAVAILABLE;
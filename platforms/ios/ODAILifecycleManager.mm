@@ -25,6 +25,10 @@ static os_log_t lifecycle_log = os_log_create("com.ondeviceai.ios", "lifecycle")
     BOOL _pauseInferenceOnBackground;
     BOOL _isInBackground;
     BOOL _isObserving;
+    BOOL _adaptivePerformanceEnabled;
+    NSInteger _baseThreadCount;
+    NSInteger _appliedThreadCount;
+    dispatch_queue_t _governorQueue;
 }
 
 - (instancetype)initWithSDKManager:(ODAISDKManager *)sdkManager {
@@ -36,6 +40,13 @@ static os_log_t lifecycle_log = os_log_create("com.ondeviceai.ios", "lifecycle")
         _pauseInferenceOnBackground = NO;
         _isInBackground = NO;
         _isObserving = NO;
+        _adaptivePerformanceEnabled = NO;
+        _baseThreadCount = 0;
+        _appliedThreadCount = 0;
+        // Thermal notifications arrive on arbitrary queues; all governor
+        // state is owned by this serial queue
+        _governorQueue = dispatch_queue_create("com.ondeviceai.ios.thermal-governor",
+                                               DISPATCH_QUEUE_SERIAL);
     }
     return self;
 }
@@ -73,6 +84,12 @@ static os_log_t lifecycle_log = os_log_create("com.ondeviceai.ios", "lifecycle")
                                name:UIApplicationDidFinishLaunchingNotification
                              object:nil];
     
+    // Thermal state notification (drives the adaptive performance governor)
+    [notificationCenter addObserver:self
+                           selector:@selector(thermalStateDidChange)
+                               name:NSProcessInfoThermalStateDidChangeNotification
+                             object:nil];
+    
     _isObserving = YES;
     LOG_INFO(@"Lifecycle observer started");
 }
@@ -98,6 +115,57 @@ static os_log_t lifecycle_log = os_log_create("com.ondeviceai.ios", "lifecycle")
     return _pauseInferenceOnBackground;
 }
 
+- (void)setAdaptivePerformanceEnabled:(BOOL)enabled baseThreadCount:(NSInteger)baseThreadCount {
+    __weak ODAILifecycleManager *weakSelf = self;
+    dispatch_async(_governorQueue, ^{
+        ODAILifecycleManager *strongSelf = weakSelf;
+        if (!strongSelf) return;
+        
+        // Restore the base thread count only if the governor lowered it, so a
+        // thread count set by the app is left alone
+        BOOL governorLowered = strongSelf->_adaptivePerformanceEnabled &&
+            strongSelf->_appliedThreadCount != 0 &&
+            strongSelf->_appliedThreadCount != strongSelf->_baseThreadCount;
+        NSInteger previousBase = strongSelf->_baseThreadCount;
+        
+        strongSelf->_adaptivePerformanceEnabled = enabled;
+        strongSelf->_baseThreadCount = MAX(baseThreadCount, 1);
+        strongSelf->_appliedThreadCount = 0;
+        LOG_INFO(@"Adaptive performance: %@ (base threads: %ld)",
+                 enabled ? @"enabled" : @"disabled", (long)strongSelf->_baseThreadCount);
+        
+        if (enabled) {
+            [strongSelf applyThermalState];
+        } else if (governorLowered && strongSelf->_sdkManager) {
+            [strongSelf->_sdkManager setThreadCount:previousBase];
+        }
+    });
+}
+
+- (BOOL)isAdaptivePerformanceEnabled {
+    __block BOOL enabled = NO;
+    dispatch_sync(_governorQueue, ^{
+        enabled = self->_adaptivePerformanceEnabled;
+    });
+    return enabled;
+}
+
++ (NSInteger)threadCountForThermalState:(NSProcessInfoThermalState)thermalState
+                        baseThreadCount:(NSInteger)baseThreadCount {
+    NSInteger base = MAX(baseThreadCount, 1);
+    switch (thermalState) {
+        case NSProcessInfoThermalStateNominal:
+            return base;
+        case NSProcessInfoThermalStateFair:
+            return MAX(base * 3 / 4, 1);
+        case NSProcessInfoThermalStateSerious:
+            return MAX(base / 2, 1);
+        case NSProcessInfoThermalStateCritical:
+            return 1;
+    }
+    return base;
+}
+
 #pragma mark - Lifecycle Event Handlers
 
 - (void)didReceiveMemoryWarning {
@@ -130,6 +198,34 @@ static os_log_t lifecycle_log = os_log_create("com.ondeviceai.ios", "lifecycle")
     // Any special setup on app launch
 }
 
+- (void)thermalStateDidChange {
+    __weak ODAILifecycleManager *weakSelf = self;
+    dispatch_async(_governorQueue, ^{
+        [weakSelf applyThermalState];
+    });
+}
+
+/// Runs on _governorQueue only
+- (void)applyThermalState {
+    if (!_adaptivePerformanceEnabled || !_sdkManager) return;
+    
+    NSProcessInfoThermalState state = [[NSProcessInfo processInfo] thermalState];
+    NSInteger threads = [ODAILifecycleManager threadCountForThermalState:state
+                                                         baseThreadCount:_baseThreadCount];
+    if (threads == _appliedThreadCount) return;
+    
+    _appliedThreadCount = threads;
+    [_sdkManager setThreadCount:threads];
+    LOG_INFO(@"Thermal state %ld: thread count set to %ld", (long)state, (long)threads);
+    
+    ODAIThermalAdjustmentHandler handler = self.thermalAdjustmentHandler;
+    if (handler) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            handler(state, threads);
+        });
+    }
+}
+
 #pragma mark - Memory Management
 
 - (void)handleMemoryWarning {
@@ -460,6 +460,29 @@ public struct GenerationConfig {
     }
 }
 
+/// Token coalescing for streamed generation
+///
+/// Tokens are delivered in batches, flushed when `maxTokens` have accumulated
+/// or `maxInterval` has passed since the first pending token, whichever comes first.
+public struct TokenBatching {
+    /// Maximum tokens per delivered batch
+    public var maxTokens: Int
+    
+    /// Maximum time a token waits before its batch is flushed (seconds)
+    public var maxInterval: TimeInterval
+    
+    /// One delivery per frame at 60 Hz, up to 16 tokens
+    public static let `default` = TokenBatching(maxTokens: 16, maxInterval: 0.016)
+    
+    /// One delivery per token (no coalescing)
+    public static let perToken = TokenBatching(maxTokens: 1, maxInterval: 0)
+    
+    public init(maxTokens: Int = 16, maxInterval: TimeInterval = 0.016) {
+        self.maxTokens = max(1, maxTokens)
+        self.maxInterval = max(0, maxInterval)
+    }
+}
+
 /// STT transcription configuration
 public struct TranscriptionConfig {
     /// Language code or "auto" for detection
@@ -77,6 +77,61 @@ export interface NativeBridge {
  */
 export const Native: NativeBridge = RawModule as NativeBridge;
 
+// ---------------------------------------------------------------------------
+// JSI host object
+// ---------------------------------------------------------------------------
+
+/**
+ * Direct C++ binding installed as `global.__OnDeviceAIJSI`.
+ * Tokens arrive through `onTokens` (coalesced while the JS thread is busy)
+ * and audio crosses as Float32 PCM ArrayBuffers without serialization.
+ */
+export interface OnDeviceAIJSI {
+  llmGenerateStreaming(
+    handle: number,
+    prompt: string,
+    config: object,
+    onTokens: (text: string) => void,
+    onDone: (error?: string) => void,
+  ): void;
+  sttTranscribe(
+    handle: number,
+    pcm: ArrayBuffer | Float32Array,
+    sampleRate: number,
+    onDone: (text: string | null, error?: string) => void,
+  ): void;
+  ttsSynthesize(
+    handle: number,
+    text: string,
+    config: object,
+    onDone: (pcm: ArrayBuffer | null, sampleRate: number, error?: string) => void,
+  ): void;
+}
+
+declare global {
+  // eslint-disable-next-line no-var
+  var __OnDeviceAIJSI: OnDeviceAIJSI | undefined;
+}
+
+let jsiInstallAttempted = false;
+
+/**
+ * Returns the JSI binding, installing it on first use. Returns null when
+ * the runtime cannot host it (e.g. remote debugging), in which case
+ * callers fall back to the promise/event bridge.
+ */
+export function getJSI(): OnDeviceAIJSI | null {
+  if (!global.__OnDeviceAIJSI && !jsiInstallAttempted) {
+    jsiInstallAttempted = true;
+    try {
+      RawModule.installJSI?.();
+    } catch {
+      // Fall back to the bridge
+    }
+  }
+  return global.__OnDeviceAIJSI ?? null;
+}
+
 // ---------------------------------------------------------------------------
 // Event emitter
 // ---------------------------------------------------------------------------
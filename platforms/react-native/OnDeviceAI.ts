@@ -6,7 +6,7 @@
  * Requirements: 7.3, 7.6, 7.8
  */
 
-import { Native, OnDeviceAIEventEmitter, Events } from './NativeModuleBridge';
+import { Native, OnDeviceAIEventEmitter, Events, getJSI } from './NativeModuleBridge';
 import type { EmitterSubscription } from 'react-native';
 
 // ---------------------------------------------------------------------------
@@ -40,6 +40,11 @@ export interface GenerationConfig {
   maxTokens?: number;
 }
 
+export interface PCMAudio {
+  samples: Float32Array;
+  sampleRate: number;
+}
+
 export interface SynthesisConfig {
   voiceId?: string;
   speed?: number;
@@ -127,6 +132,15 @@ export class LLMEngine {
     onToken: (token: string) => void,
     config?: GenerationConfig,
   ): Promise<void> {
+    const jsi = getJSI();
+    if (jsi) {
+      return new Promise((resolve, reject) => {
+        jsi.llmGenerateStreaming(handle, prompt, config ?? {}, onToken, (error) =>
+          error ? reject(new Error(error)) : resolve(),
+        );
+      });
+    }
+
     const sub = OnDeviceAIEventEmitter.addListener(
       Events.TOKEN,
       (evt: { token: string }) => onToken(evt.token),
@@ -155,6 +169,19 @@ export class STTEngine {
   async transcribe(handle: number, audioUri: string): Promise<string> {
     return Native.sttTranscribe(handle, audioUri);
   }
+
+  /** Transcribe mono Float32 PCM in memory. Requires the JSI binding. */
+  async transcribePCM(handle: number, samples: Float32Array, sampleRate = 16000): Promise<string> {
+    const jsi = getJSI();
+    if (!jsi) {
+      throw new Error('transcribePCM requires the OnDeviceAI JSI binding');
+    }
+    return new Promise((resolve, reject) => {
+      jsi.sttTranscribe(handle, samples, sampleRate, (text, error) =>
+        error || text === null ? reject(new Error(error ?? 'Transcription failed')) : resolve(text),
+      );
+    });
+  }
 }
 
 // ---------------------------------------------------------------------------
@@ -178,6 +205,24 @@ export class TTSEngine {
     // Returns a file URI to the synthesized audio
     return Native.ttsSynthesize(handle, text, JSON.stringify(config ?? {}));
   }
+
+  /**
+   * Synthesize to Float32 PCM backed by native memory instead of a file.
+   * Requires the JSI binding.
+   */
+  async synthesizePCM(handle: number, text: string, config?: SynthesisConfig): Promise<PCMAudio> {
+    const jsi = getJSI();
+    if (!jsi) {
+      throw new Error('synthesizePCM requires the OnDeviceAI JSI binding');
+    }
+    return new Promise((resolve, reject) => {
+      jsi.ttsSynthesize(handle, text, config ?? {}, (pcm, sampleRate, error) =>
+        error || pcm === null
+          ? reject(new Error(error ?? 'Synthesis failed'))
+          : resolve({ samples: new Float32Array(pcm), sampleRate }),
+      );
+    });
+  }
 }
 
 // ---------------------------------------------------------------------------
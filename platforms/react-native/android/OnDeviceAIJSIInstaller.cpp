@@ -0,0 +1,30 @@
+/**
+ * OnDeviceAIJSIInstaller.cpp
+ * React Native Android — installs the JSI host object into the JS runtime.
+ *
+ * Called from OnDeviceAIModule.installJSI() on the JS thread with the
+ * runtime pointer and CallInvokerHolder taken from the ReactContext.
+ *
+ * Requirements: 7.3, 7.8
+ */
+
+#include <jni.h>
+#include <fbjni/fbjni.h>
+#include <jsi/jsi.h>
+#include <ReactCommon/CallInvokerHolder.h>
+
+#include "../cpp/OnDeviceAIJSI.h"
+
+using namespace facebook;
+
+extern "C" JNIEXPORT jboolean JNICALL
+Java_com_ondeviceai_reactnative_OnDeviceAIModule_nativeInstallJSI(
+    JNIEnv* env, jobject /* obj */, jlong runtimePtr, jobject callInvokerHolder) {
+    auto* runtime = reinterpret_cast<jsi::Runtime*>(runtimePtr);
+    if (!runtime || !callInvokerHolder) return JNI_FALSE;
+
+    auto holder = jni::alias_ref<react::CallInvokerHolder::javaobject>(
+        static_cast<react::CallInvokerHolder::javaobject>(callInvokerHolder));
+    ondeviceai::rn::install(*runtime, holder->cthis()->getCallInvoker());
+    return JNI_TRUE;
+}
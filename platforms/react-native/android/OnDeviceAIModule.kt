@@ -2,6 +2,7 @@ package com.ondeviceai.reactnative
 
 import com.facebook.react.bridge.*
 import com.facebook.react.modules.core.DeviceEventManagerModule
+import com.facebook.react.turbomodule.core.CallInvokerHolderImpl
 import com.ondeviceai.*
 import kotlinx.coroutines.*
 
@@ -22,6 +23,32 @@ class OnDeviceAIModule(private val reactContext: ReactApplicationContext) :
             .emit(event, params)
     }
 
+    // -----------------------------------------------------------------------
+    // JSI
+    // -----------------------------------------------------------------------
+
+    /**
+     * Install `global.__OnDeviceAIJSI` into the JS runtime. Must run
+     * synchronously on the JS thread; returns false when the runtime is
+     * not reachable (e.g. remote debugging) or libondeviceai_jsi.so is not
+     * packaged, in which case JS falls back to the event-based methods below.
+     */
+    @ReactMethod(isBlockingSynchronousMethod = true)
+    fun installJSI(): Boolean {
+        val runtimePtr = reactContext.javaScriptContextHolder?.get() ?: 0L
+        if (runtimePtr == 0L) return false
+        val holder = reactContext.catalystInstance.jsCallInvokerHolder as? CallInvokerHolderImpl
+            ?: return false
+        try {
+            System.loadLibrary("ondeviceai_jsi")
+        } catch (e: UnsatisfiedLinkError) {
+            return false
+        }
+        return nativeInstallJSI(runtimePtr, holder)
+    }
+
+    private external fun nativeInstallJSI(runtimePtr: Long, callInvokerHolder: CallInvokerHolderImpl): Boolean
+
     // -----------------------------------------------------------------------
     // SDK lifecycle
     // -----------------------------------------------------------------------
@@ -0,0 +1,73 @@
+plugins {
+    id("com.android.library")
+    id("org.jetbrains.kotlin.android")
+}
+
+android {
+    namespace = "com.ondeviceai.reactnative"
+    compileSdk = 34
+
+    defaultConfig {
+        minSdk = 24
+        targetSdk = 34
+        consumerProguardFiles("consumer-rules.pro")
+
+        ndk {
+            abiFilters += listOf("arm64-v8a", "armeabi-v7a", "x86_64")
+        }
+
+        externalNativeBuild {
+            cmake {
+                cppFlags("-std=c++17 -fexceptions -frtti")
+                arguments("-DANDROID_STL=c++_shared")
+                targets("ondeviceai_jsi")
+            }
+        }
+    }
+
+    // jsi / ReactCommon / fbjni headers and libraries
+    buildFeatures {
+        prefab = true
+    }
+
+    externalNativeBuild {
+        cmake {
+            path = file("CMakeLists.txt")
+            version = "3.22.1"
+        }
+    }
+
+    sourceSets["main"].java.srcDirs(".")
+
+    packaging {
+        jniLibs {
+            // Shipped by react-android, fbjni and the OnDevice AI SDK itself;
+            // this module only contributes libondeviceai_jsi.so
+            excludes += listOf(
+                "**/libc++_shared.so",
+                "**/libfbjni.so",
+                "**/libjsi.so",
+                "**/libreactnativejni.so",
+                "**/libondeviceai.so"
+            )
+        }
+    }
+
+    compileOptions {
+        sourceCompatibility = JavaVersion.VERSION_11
+        targetCompatibility = JavaVersion.VERSION_11
+    }
+
+    kotlinOptions {
+        jvmTarget = "11"
+    }
+}
+
+dependencies {
+    // Version is resolved by the React Native Gradle plugin of the host app
+    implementation("com.facebook.react:react-android")
+    implementation("com.facebook.fbjni:fbjni:0.5.1")
+    // OnDevice AI Android SDK (platforms/android), included by the host app
+    implementation(project(":ondeviceai"))
+    implementation("org.jetbrains.kotlinx:kotlinx-coroutines-android:1.7.3")
+}
@@ -0,0 +1,435 @@
+/**
+ * OnDeviceAIJSI.cpp
+ * React Native JSI binding — host object that calls the C++ core directly.
+ *
+ * Requirements: 7.3, 7.8
+ */
+
+#include "OnDeviceAIJSI.h"
+
+#include "ondeviceai/sdk_manager.hpp"
+#include "ondeviceai/llm_engine.hpp"
+#include "ondeviceai/stt_engine.hpp"
+#include "ondeviceai/tts_engine.hpp"
+#include "ondeviceai/types.hpp"
+
+#include "../../common/stream_completion.h"
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+using namespace facebook;
+
+namespace ondeviceai {
+namespace rn {
+
+namespace {
+
+constexpr const char* kPropLLMGenerateStreaming = "llmGenerateStreaming";
+constexpr const char* kPropSTTTranscribe        = "sttTranscribe";
+constexpr const char* kPropTTSSynthesize        = "ttsSynthesize";
+
+/// ArrayBuffer storage that owns synthesized PCM, so JS reads the samples
+/// in place instead of receiving a base64 or file round-trip.
+class PCMBuffer : public jsi::MutableBuffer {
+public:
+    explicit PCMBuffer(std::vector<float> samples) : samples_(std::move(samples)) {}
+
+    size_t size() const override { return samples_.size() * sizeof(float); }
+    uint8_t* data() override { return reinterpret_cast<uint8_t*>(samples_.data()); }
+
+private:
+    std::vector<float> samples_;
+};
+
+/// Tokens produced by dispatcher callbacks that have not reached JS yet.
+/// While a flush is queued, new tokens are appended instead of posting
+/// another JS call, so a busy JS thread receives one coalesced string.
+/// Appends follow callback order, which is generation order because the
+/// native modules run the dispatcher with a single callback thread.
+struct PendingTokens {
+    std::mutex mutex;
+    std::string text;
+    bool flush_scheduled = false;
+    std::string error;  // set once generateStreaming() returns
+};
+
+double numberProp(jsi::Runtime& rt, const jsi::Object& obj, const char* name, double fallback) {
+    jsi::Value v = obj.getProperty(rt, name);
+    return v.isNumber() ? v.asNumber() : fallback;
+}
+
+GenerationConfig parseGenerationConfig(jsi::Runtime& rt, const jsi::Value& value) {
+    GenerationConfig config;
+    if (!value.isObject()) return config;
+    jsi::Object obj = value.asObject(rt);
+    config.temperature = static_cast<float>(numberProp(rt, obj, "temperature", config.temperature));
+    config.top_p       = static_cast<float>(numberProp(rt, obj, "topP", config.top_p));
+    config.max_tokens  = static_cast<int>(numberProp(rt, obj, "maxTokens", config.max_tokens));
+    return config;
+}
+
+SynthesisConfig parseSynthesisConfig(jsi::Runtime& rt, const jsi::Value& value) {
+    SynthesisConfig config;
+    if (!value.isObject()) return config;
+    jsi::Object obj = value.asObject(rt);
+    config.speed = static_cast<float>(numberProp(rt, obj, "speed", config.speed));
+    config.pitch = static_cast<float>(numberProp(rt, obj, "pitch", config.pitch));
+    return config;
+}
+
+/// Copy Float32 PCM out of an ArrayBuffer or typed-array view. The copy is
+/// required because the JS heap may move or collect the buffer once
+/// inference leaves the JS thread.
+std::vector<float> readPCM(jsi::Runtime& rt, const jsi::Value& value) {
+    if (!value.isObject()) {
+        throw jsi::JSError(rt, "Expected an ArrayBuffer or Float32Array of PCM samples");
+    }
+    jsi::Object obj = value.asObject(rt);
+
+    size_t offset = 0;
+    size_t length = 0;
+    jsi::ArrayBuffer buffer = [&]() {
+        if (obj.isArrayBuffer(rt)) {
+            jsi::ArrayBuffer ab = obj.getArrayBuffer(rt);
+            length = ab.size(rt);
+            return ab;
+        }
+        jsi::Value backing = obj.getProperty(rt, "buffer");
+        if (!backing.isObject() || !backing.asObject(rt).isArrayBuffer(rt)) {
+            throw jsi::JSError(rt, "Expected an ArrayBuffer or Float32Array of PCM samples");
+        }
+        offset = static_cast<size_t>(numberProp(rt, obj, "byteOffset", 0));
+        length = static_cast<size_t>(numberProp(rt, obj, "byteLength", 0));
+        return backing.asObject(rt).getArrayBuffer(rt);
+    }();
+
+    const size_t capacity = buffer.size(rt);
+    if (offset > capacity || length > capacity - offset) {
+        throw jsi::JSError(rt, "PCM view exceeds the bounds of its ArrayBuffer");
+    }
+
+    std::vector<float> samples(length / sizeof(float));
+    if (!samples.empty()) {
+        std::memcpy(samples.data(), buffer.data(rt) + offset, samples.size() * sizeof(float));
+    }
+    return samples;
+}
+
+void requireArgs(jsi::Runtime& rt, size_t count, size_t expected, const char* method) {
+    if (count < expected) {
+        throw jsi::JSError(rt, std::string(method) + ": expected " +
+                               std::to_string(expected) + " arguments");
+    }
+}
+
+} // namespace
+
+/// JS callbacks for one request. Only created, called and destroyed on
+/// the JS thread; workers refer to them by request id.
+struct JSCallbacks {
+    explicit JSCallbacks(jsi::Function done, std::optional<jsi::Function> data = std::nullopt)
+        : onDone(std::move(done)), onData(std::move(data)) {}
+
+    jsi::Function onDone;
+    std::optional<jsi::Function> onData;  // streaming requests only
+};
+
+/// The worker threads' only path to the runtime. Holds the request
+/// callbacks on the JS thread and gates every post on `valid_`, which the
+/// host object clears on teardown, so a late result never touches a dead
+/// runtime or destroys a jsi::Function outside it.
+class JSSession {
+public:
+    using Task = std::function<void(jsi::Runtime&, JSCallbacks&)>;
+
+    JSSession(jsi::Runtime& runtime, std::shared_ptr<react::CallInvoker> invoker)
+        : runtime_(&runtime), invoker_(std::move(invoker)) {}
+
+    /// JS thread: keep `callbacks` until the request's final post
+    uint64_t retain(JSCallbacks callbacks) {
+        uint64_t id = next_id_++;
+        callbacks_.emplace(id, std::move(callbacks));
+        return id;
+    }
+
+    /// Any thread: run `task` on the JS thread with the callbacks of `id`.
+    /// `last` releases them afterwards. Dropped once invalidated.
+    static void post(const std::shared_ptr<JSSession>& session, uint64_t id, Task task,
+                     bool last = false) {
+        std::shared_ptr<react::CallInvoker> invoker;
+        {
+            std::lock_guard<std::mutex> lock(session->mutex_);
+            if (!session->valid_) return;
+            invoker = session->invoker_;
+        }
+        invoker->invokeAsync([session, id, task = std::move(task), last]() {
+            // invalidate() also runs on the JS thread, so this check holds
+            if (!session->isValid()) return;
+            auto it = session->callbacks_.find(id);
+            if (it == session->callbacks_.end()) return;
+            task(*session->runtime_, it->second);
+            if (last) session->callbacks_.erase(id);
+        });
+    }
+
+    /// JS thread: drop all callbacks and refuse further posts
+    void invalidate() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            valid_ = false;
+            invoker_.reset();
+        }
+        callbacks_.clear();
+    }
+
+private:
+    bool isValid() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return valid_;
+    }
+
+    std::mutex mutex_;
+    bool valid_ = true;
+    jsi::Runtime* runtime_;
+    std::shared_ptr<react::CallInvoker> invoker_;
+
+    // JS thread only
+    std::unordered_map<uint64_t, JSCallbacks> callbacks_;
+    uint64_t next_id_ = 1;
+};
+
+OnDeviceAIHostObject::OnDeviceAIHostObject(jsi::Runtime& runtime,
+                                           std::shared_ptr<react::CallInvoker> jsInvoker)
+    : session_(std::make_shared<JSSession>(runtime, std::move(jsInvoker))) {}
+
+OnDeviceAIHostObject::~OnDeviceAIHostObject() {
+    session_->invalidate();
+}
+
+jsi::Value OnDeviceAIHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID& name) {
+    const std::string prop = name.utf8(runtime);
+
+    using Method = jsi::Value (OnDeviceAIHostObject::*)(jsi::Runtime&, const jsi::Value*, size_t);
+    // Functions keep the host object alive, so JS may cache them safely
+    auto bind = [&](Method method, unsigned int argc) {
+        return jsi::Function::createFromHostFunction(
+            runtime, name, argc,
+            [self = shared_from_this(), method](jsi::Runtime& rt, const jsi::Value&,
+                                                const jsi::Value* args, size_t count) {
+                return ((*self).*method)(rt, args, count);
+            });
+    };
+
+    if (prop == kPropLLMGenerateStreaming) return bind(&OnDeviceAIHostObject::llmGenerateStreaming, 5);
+    if (prop == kPropSTTTranscribe)        return bind(&OnDeviceAIHostObject::sttTranscribe, 4);
+    if (prop == kPropTTSSynthesize)        return bind(&OnDeviceAIHostObject::ttsSynthesize, 4);
+    return jsi::Value::undefined();
+}
+
+std::vector<jsi::PropNameID> OnDeviceAIHostObject::getPropertyNames(jsi::Runtime& runtime) {
+    std::vector<jsi::PropNameID> names;
+    names.push_back(jsi::PropNameID::forAscii(runtime, kPropLLMGenerateStreaming));
+    names.push_back(jsi::PropNameID::forAscii(runtime, kPropSTTTranscribe));
+    names.push_back(jsi::PropNameID::forAscii(runtime, kPropTTSSynthesize));
+    return names;
+}
+
+// ---------------------------------------------------------------------------
+// LLM
+// ---------------------------------------------------------------------------
+
+jsi::Value OnDeviceAIHostObject::llmGenerateStreaming(jsi::Runtime& runtime,
+                                                      const jsi::Value* args, size_t count) {
+    requireArgs(runtime, count, 5, kPropLLMGenerateStreaming);
+
+    auto handle = static_cast<ModelHandle>(args[0].asNumber());
+    std::string prompt = args[1].asString(runtime).utf8(runtime);
+    GenerationConfig config = parseGenerationConfig(runtime, args[2]);
+    auto session = session_;
+    const uint64_t id = session->retain(JSCallbacks(
+        args[4].asObject(runtime).asFunction(runtime),
+        args[3].asObject(runtime).asFunction(runtime)));
+
+    std::thread([session, id, handle, prompt = std::move(prompt), config]() {
+        // Shared with dispatcher callbacks, which may run on other threads
+        auto pending = std::make_shared<PendingTokens>();
+
+        auto drain = [pending](jsi::Runtime& rt, JSCallbacks& callbacks) {
+            std::string text;
+            {
+                std::lock_guard<std::mutex> lock(pending->mutex);
+                text.swap(pending->text);
+                pending->flush_scheduled = false;
+            }
+            if (!text.empty() && callbacks.onData) {
+                callbacks.onData->call(rt, jsi::String::createFromUtf8(rt, text));
+            }
+        };
+
+        // onDone is posted once this request's last token callback has
+        // finished (and posted its flush), independent of other streams
+        auto completion = std::make_shared<bridge::StreamCompletion>(
+            [session, id, pending, drain]() {
+                std::string error;
+                {
+                    std::lock_guard<std::mutex> lock(pending->mutex);
+                    error = pending->error;
+                }
+                JSSession::post(session, id,
+                    [drain, error = std::move(error)](jsi::Runtime& rt, JSCallbacks& callbacks) {
+                        drain(rt, callbacks);
+                        if (error.empty()) {
+                            callbacks.onDone.call(rt);
+                        } else {
+                            callbacks.onDone.call(rt, jsi::String::createFromUtf8(rt, error));
+                        }
+                    },
+                    /*last=*/true);
+            });
+
+        std::string error;
+        auto* mgr = SDKManager::getInstance();
+        if (!mgr) {
+            error = "SDK not initialized";
+        } else {
+            auto result = mgr->getLLMEngine()->generateStreaming(
+                handle, prompt,
+                // `completion` is only held: each queued copy of this
+                // callback keeps it alive until that token has been handled
+                [session, id, pending, drain, completion](const std::string& token) {
+                    bool schedule = false;
+                    {
+                        std::lock_guard<std::mutex> lock(pending->mutex);
+                        pending->text += token;
+                        if (!pending->flush_scheduled) {
+                            pending->flush_scheduled = true;
+                            schedule = true;
+                        }
+                    }
+                    if (schedule) JSSession::post(session, id, drain);
+                },
+                config);
+            if (result.isError()) error = result.error().message;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(pending->mutex);
+            pending->error = std::move(error);
+        }
+        completion.reset();
+    }).detach();
+
+    return jsi::Value::undefined();
+}
+
+// ---------------------------------------------------------------------------
+// STT
+// ---------------------------------------------------------------------------
+
+jsi::Value OnDeviceAIHostObject::sttTranscribe(jsi::Runtime& runtime,
+                                               const jsi::Value* args, size_t count) {
+    requireArgs(runtime, count, 4, kPropSTTTranscribe);
+
+    auto handle = static_cast<ModelHandle>(args[0].asNumber());
+    AudioData audio;
+    audio.samples     = readPCM(runtime, args[1]);
+    audio.sample_rate = static_cast<int>(args[2].asNumber());
+    audio.channels    = 1;
+    auto session = session_;
+    const uint64_t id = session->retain(JSCallbacks(args[3].asObject(runtime).asFunction(runtime)));
+
+    std::thread([session, id, handle, audio = std::move(audio)]() {
+        std::string text;
+        std::string error;
+        auto* mgr = SDKManager::getInstance();
+        if (!mgr) {
+            error = "SDK not initialized";
+        } else {
+            TranscriptionConfig tCfg;
+            auto result = mgr->getSTTEngine()->transcribe(handle, audio, tCfg);
+            if (result.isError()) {
+                error = result.error().message;
+            } else {
+                text = result.value().text;
+            }
+        }
+
+        JSSession::post(session, id,
+            [text = std::move(text), error = std::move(error)](jsi::Runtime& rt, JSCallbacks& callbacks) {
+                if (error.empty()) {
+                    callbacks.onDone.call(rt, jsi::String::createFromUtf8(rt, text));
+                } else {
+                    callbacks.onDone.call(rt, jsi::Value::null(), jsi::String::createFromUtf8(rt, error));
+                }
+            },
+            /*last=*/true);
+    }).detach();
+
+    return jsi::Value::undefined();
+}
+
+// ---------------------------------------------------------------------------
+// TTS
+// ---------------------------------------------------------------------------
+
+jsi::Value OnDeviceAIHostObject::ttsSynthesize(jsi::Runtime& runtime,
+                                               const jsi::Value* args, size_t count) {
+    requireArgs(runtime, count, 4, kPropTTSSynthesize);
+
+    auto handle = static_cast<ModelHandle>(args[0].asNumber());
+    std::string text = args[1].asString(runtime).utf8(runtime);
+    SynthesisConfig sCfg = parseSynthesisConfig(runtime, args[2]);
+    auto session = session_;
+    const uint64_t id = session->retain(JSCallbacks(args[3].asObject(runtime).asFunction(runtime)));
+
+    std::thread([session, id, handle, text = std::move(text), sCfg]() {
+        std::vector<float> samples;
+        int sampleRate = 0;
+        std::string error;
+        auto* mgr = SDKManager::getInstance();
+        if (!mgr) {
+            error = "SDK not initialized";
+        } else {
+            auto result = mgr->getTTSEngine()->synthesize(handle, text, sCfg);
+            if (result.isError()) {
+                error = result.error().message;
+            } else {
+                samples    = std::move(result.value().samples);
+                sampleRate = result.value().sample_rate;
+            }
+        }
+
+        // Shared so the std::function task stays copyable
+        auto pcmSamples = std::make_shared<std::vector<float>>(std::move(samples));
+        JSSession::post(session, id,
+            [pcmSamples, sampleRate, error = std::move(error)](jsi::Runtime& rt, JSCallbacks& callbacks) {
+                if (!error.empty()) {
+                    callbacks.onDone.call(rt, jsi::Value::null(), 0, jsi::String::createFromUtf8(rt, error));
+                    return;
+                }
+                jsi::ArrayBuffer pcm(rt, std::make_shared<PCMBuffer>(std::move(*pcmSamples)));
+                callbacks.onDone.call(rt, std::move(pcm), sampleRate);
+            },
+            /*last=*/true);
+    }).detach();
+
+    return jsi::Value::undefined();
+}
+
+// ---------------------------------------------------------------------------
+
+void install(jsi::Runtime& runtime, std::shared_ptr<react::CallInvoker> jsInvoker) {
+    auto host = std::make_shared<OnDeviceAIHostObject>(runtime, std::move(jsInvoker));
+    runtime.global().setProperty(runtime, "__OnDeviceAIJSI",
+                                 jsi::Object::createFromHostObject(runtime, host));
+}
+
+} // namespace rn
+} // namespace ondeviceai
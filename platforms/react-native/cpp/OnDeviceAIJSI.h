@@ -0,0 +1,72 @@
+/**
+ * OnDeviceAIJSI.h
+ * React Native JSI binding — host object that calls the C++ core directly.
+ *
+ * Installed as `global.__OnDeviceAIJSI`. Streamed tokens are delivered
+ * through JSI function calls on the JS thread and audio crosses as
+ * ArrayBuffers backed by native memory, bypassing JSON bridge events.
+ *
+ * Requirements: 7.3, 7.8
+ */
+
+#pragma once
+
+#include <jsi/jsi.h>
+#include <ReactCommon/CallInvoker.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ondeviceai {
+namespace rn {
+
+/// Runtime access shared with worker threads (defined in OnDeviceAIJSI.cpp)
+class JSSession;
+
+/**
+ * JSI host object exposing streaming LLM, STT and TTS entry points.
+ *
+ * Inference runs on a background thread; results are posted back with
+ * CallInvoker::invokeAsync, so every jsi::Value is only touched on the
+ * JS thread. Workers reach the runtime only through a JSSession, which the
+ * host object invalidates when it is destroyed (JS reload or teardown), so
+ * late results are dropped instead of touching a dead runtime.
+ */
+class OnDeviceAIHostObject : public facebook::jsi::HostObject,
+                             public std::enable_shared_from_this<OnDeviceAIHostObject> {
+public:
+    OnDeviceAIHostObject(facebook::jsi::Runtime& runtime,
+                         std::shared_ptr<facebook::react::CallInvoker> jsInvoker);
+    ~OnDeviceAIHostObject() override;
+
+    facebook::jsi::Value get(facebook::jsi::Runtime& runtime,
+                             const facebook::jsi::PropNameID& name) override;
+
+    std::vector<facebook::jsi::PropNameID> getPropertyNames(facebook::jsi::Runtime& runtime) override;
+
+private:
+    /// llmGenerateStreaming(handle, prompt, config, onTokens(text), onDone(error?))
+    facebook::jsi::Value llmGenerateStreaming(facebook::jsi::Runtime& runtime,
+                                              const facebook::jsi::Value* args, size_t count);
+
+    /// sttTranscribe(handle, pcm: ArrayBuffer | Float32Array, sampleRate, onDone(text, error?))
+    facebook::jsi::Value sttTranscribe(facebook::jsi::Runtime& runtime,
+                                       const facebook::jsi::Value* args, size_t count);
+
+    /// ttsSynthesize(handle, text, config, onDone(pcm: ArrayBuffer | null, sampleRate, error?))
+    facebook::jsi::Value ttsSynthesize(facebook::jsi::Runtime& runtime,
+                                       const facebook::jsi::Value* args, size_t count);
+
+    std::shared_ptr<JSSession> session_;
+};
+
+/**
+ * Install the host object as `global.__OnDeviceAIJSI`.
+ * Must be called on the JS thread.
+ */
+void install(facebook::jsi::Runtime& runtime,
+             std::shared_ptr<facebook::react::CallInvoker> jsInvoker);
+
+} // namespace rn
+} // namespace ondeviceai
@@ -10,6 +10,9 @@
 
 #import <React/RCTBridgeModule.h>
 #import <React/RCTEventEmitter.h>
+#import <React/RCTBridge+Private.h>
+#import <ReactCommon/RCTTurboModule.h>
+#include "../cpp/OnDeviceAIJSI.h"
 #include "ondeviceai/sdk_manager.hpp"
 #include "ondeviceai/llm_engine.hpp"
 #include "ondeviceai/stt_engine.hpp"
@@ -32,6 +35,23 @@ RCT_EXPORT_MODULE(OnDeviceAI);
 
 + (BOOL)requiresMainQueueSetup { return NO; }
 
+// ---------------------------------------------------------------------------
+// JSI
+// ---------------------------------------------------------------------------
+
+/// Install `global.__OnDeviceAIJSI` into the JS runtime. Runs synchronously
+/// on the JS thread; returns NO when no JSI runtime is reachable (e.g.
+/// remote debugging), in which case JS keeps using the event-based methods.
+RCT_EXPORT_BLOCKING_SYNCHRONOUS_METHOD(installJSI)
+{
+    RCTCxxBridge *cxxBridge = (RCTCxxBridge *)self.bridge;
+    if (!cxxBridge || !cxxBridge.runtime) return @NO;
+
+    auto &runtime = *static_cast<facebook::jsi::Runtime *>(cxxBridge.runtime);
+    ondeviceai::rn::install(runtime, cxxBridge.jsCallInvoker);
+    return @YES;
+}
+
 - (NSArray<NSString *> *)supportedEvents {
     return @[
         @"ondeviceai_token",
@@ -57,6 +77,8 @@ RCT_EXPORT_METHOD(initialize:(NSString *)configJson
         config.thread_count = 2;
         config.memory_limit = 500 * 1024 * 1024;
         config.log_level    = LogLevel::Info;
+        // One callback thread keeps streamed tokens in generation order
+        config.callback_thread_count = 1;
 
         // If the caller sent a model directory, pass it through
         NSData *data = [configJson dataUsingEncoding:NSUTF8StringEncoding];
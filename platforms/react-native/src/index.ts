@@ -1,3 +1,3 @@
 export { OnDeviceAI, SDKError, ModelManager, LLMEngine, STTEngine, TTSEngine, VoicePipeline, LifecycleManager } from './OnDeviceAI';
-export type { SDKConfig, ModelInfo, StorageInfo, GenerationConfig, SynthesisConfig } from './OnDeviceAI';
+export type { SDKConfig, ModelInfo, StorageInfo, GenerationConfig, SynthesisConfig, PCMAudio } from './OnDeviceAI';
 export { Events, OnDeviceAIEventEmitter } from './NativeModuleBridge';
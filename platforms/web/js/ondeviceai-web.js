@@ -0,0 +1,122 @@
+/**
+ * ondeviceai-web.js
+ * Main-thread client for the OnDeviceAI WASM worker.
+ *
+ * Every call is forwarded to ondeviceai.worker.js, so the page's thread
+ * is never blocked by model loading or inference. Requires a
+ * cross-origin isolated page (COOP/COEP) for SharedArrayBuffer.
+ */
+
+export class OnDeviceAIWeb {
+  constructor(workerUrl = new URL('./ondeviceai.worker.js', import.meta.url)) {
+    if (!globalThis.crossOriginIsolated) {
+      throw new Error('OnDeviceAI requires a cross-origin isolated page (COOP/COEP headers)');
+    }
+    this.worker = new Worker(workerUrl, { type: 'module' });
+    this.nextId = 1;
+    this.pending = new Map();
+    this.worker.onmessage = ({ data }) => this.handleMessage(data);
+  }
+
+  handleMessage(data) {
+    const request = this.pending.get(data.id);
+    if (!request) return;
+
+    if (data.type === 'token') {
+      request.onToken?.(data.text);
+      return;
+    }
+    if (data.type === 'progress') {
+      request.onProgress?.(data.received, data.total);
+      return;
+    }
+
+    this.pending.delete(data.id);
+    if (data.error) {
+      const err = new Error(data.error.message);
+      err.code = data.error.code;
+      request.reject(err);
+    } else {
+      request.resolve(data.value);
+    }
+  }
+
+  request(type, args = {}, hooks = {}, transfer = []) {
+    const id = this.nextId++;
+    return new Promise((resolve, reject) => {
+      this.pending.set(id, { resolve, reject, ...hooks });
+      this.worker.postMessage({ id, type, ...args }, transfer);
+    });
+  }
+
+  // SDK -----------------------------------------------------------------
+
+  initialize({ threadCount, memoryLimitBytes } = {}) {
+    return this.request('initialize', { threadCount, memoryLimitBytes });
+  }
+
+  shutdown() {
+    return this.request('shutdown');
+  }
+
+  /** Stream a model into OPFS; resolves with the path for load*Model */
+  downloadModel(url, name, onProgress) {
+    return this.request('downloadModel', { url, name }, { onProgress });
+  }
+
+  deleteModel(name) {
+    return this.request('deleteModel', { name });
+  }
+
+  // LLM -----------------------------------------------------------------
+
+  llmLoadModel(path) {
+    return this.request('llmLoadModel', { path });
+  }
+
+  llmUnloadModel(handle) {
+    return this.request('llmUnloadModel', { handle });
+  }
+
+  generateStreaming(handle, prompt, onToken, config = {}, batchTokens = 8) {
+    return this.request('llmGenerate', { handle, prompt, config, batchTokens }, { onToken });
+  }
+
+  // STT -----------------------------------------------------------------
+
+  sttLoadModel(path) {
+    return this.request('sttLoadModel', { path });
+  }
+
+  sttUnloadModel(handle) {
+    return this.request('sttUnloadModel', { handle });
+  }
+
+  /** `samples` is a mono Float32Array; its buffer is transferred to the worker */
+  transcribe(handle, samples, sampleRate = 16000) {
+    return this.request('sttTranscribe', { handle, samples, sampleRate }, {}, [samples.buffer]);
+  }
+
+  // TTS -----------------------------------------------------------------
+
+  ttsLoadModel(path) {
+    return this.request('ttsLoadModel', { path });
+  }
+
+  ttsUnloadModel(handle) {
+    return this.request('ttsUnloadModel', { handle });
+  }
+
+  /** Resolves with { samples: Float32Array, sampleRate } */
+  synthesize(handle, text, config = {}) {
+    return this.request('ttsSynthesize', { handle, text, config });
+  }
+
+  terminate() {
+    this.worker.terminate();
+    for (const { reject } of this.pending.values()) {
+      reject(new Error('Worker terminated'));
+    }
+    this.pending.clear();
+  }
+}
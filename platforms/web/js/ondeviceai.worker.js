@@ -0,0 +1,163 @@
+/**
+ * ondeviceai.worker.js
+ * Dedicated worker hosting the OnDeviceAI WASM module.
+ *
+ * All inference runs here (and on the module's pthread pool), never on
+ * the page's main thread. Model files are streamed from the network
+ * straight into OPFS, so a multi-GB model is never buffered in the JS heap.
+ *
+ * Protocol: the page posts { id, type, ...args }; the worker answers
+ * { id, value } or { id, error }, plus { id, type: 'token', text } while
+ * a generation streams.
+ */
+
+import createOnDeviceAIModule from './ondeviceai.js';
+
+const MODELS_DIR = 'models';
+const OPFS_MOUNT = '/opfs';
+
+let modulePromise = null;
+
+function getModule() {
+  if (!modulePromise) {
+    modulePromise = createOnDeviceAIModule().then((Module) => {
+      if (!Module.mountOPFS()) {
+        throw new Error('Origin-private file system is not available');
+      }
+      return Module;
+    });
+  }
+  return modulePromise;
+}
+
+/** Unwrap a { value } / { error } result object from the bindings */
+function unwrap(result) {
+  if (result.error) {
+    const err = new Error(result.error.message);
+    err.code = result.error.code;
+    throw err;
+  }
+  return result.value;
+}
+
+async function modelsDirectory() {
+  const root = await navigator.storage.getDirectory();
+  return root.getDirectoryHandle(MODELS_DIR, { create: true });
+}
+
+/**
+ * Stream `url` into OPFS as `name`, reporting progress. Returns the WasmFS
+ * path the core can open.
+ */
+async function downloadModel(id, url, name) {
+  const dir = await modelsDirectory();
+  const path = `${OPFS_MOUNT}/${MODELS_DIR}/${name}`;
+
+  try {
+    const existing = await dir.getFileHandle(name);
+    if ((await existing.getFile()).size > 0) return path;
+  } catch {
+    // Not downloaded yet
+  }
+
+  const response = await fetch(url);
+  if (!response.ok || !response.body) {
+    throw new Error(`Download failed: HTTP ${response.status}`);
+  }
+  const total = Number(response.headers.get('Content-Length')) || 0;
+  let received = 0;
+
+  const progress = new TransformStream({
+    transform(chunk, controller) {
+      received += chunk.byteLength;
+      self.postMessage({ id, type: 'progress', received, total });
+      controller.enqueue(chunk);
+    },
+  });
+
+  const handle = await dir.getFileHandle(name, { create: true });
+  const writable = await handle.createWritable();
+  await response.body.pipeThrough(progress).pipeTo(writable);
+  return path;
+}
+
+async function deleteModel(name) {
+  const dir = await modelsDirectory();
+  await dir.removeEntry(name);
+}
+
+function generate(Module, id, { handle, prompt, config, batchTokens }) {
+  return new Promise((resolve, reject) => {
+    unwrap(Module.llmGenerateStreaming(handle, prompt, config ?? {}, {
+      onTokens: (text) => self.postMessage({ id, type: 'token', text }),
+      onDone: (error) => (error ? reject(new Error(error)) : resolve()),
+    }, batchTokens ?? 8) ?? {});
+  });
+}
+
+function transcribe(Module, { handle, samples, sampleRate }) {
+  return new Promise((resolve, reject) => {
+    unwrap(Module.sttTranscribe(handle, samples, sampleRate ?? 16000, {
+      onDone: (text, error) => (error ? reject(new Error(error)) : resolve(text)),
+    }) ?? {});
+  });
+}
+
+function synthesize(Module, { handle, text, config }) {
+  return new Promise((resolve, reject) => {
+    unwrap(Module.ttsSynthesize(handle, text, config ?? {}, {
+      onDone: (samples, sampleRate, error) =>
+        error ? reject(new Error(error)) : resolve({ samples, sampleRate }),
+    }) ?? {});
+  });
+}
+
+async function dispatch(id, msg) {
+  const Module = await getModule();
+  switch (msg.type) {
+    case 'initialize':
+      return unwrap(Module.initialize(
+        `${OPFS_MOUNT}/${MODELS_DIR}`,
+        msg.threadCount ?? navigator.hardwareConcurrency ?? 4,
+        msg.memoryLimitBytes ?? 1024 * 1024 * 1024,
+      ));
+    case 'shutdown':
+      return Module.shutdown();
+    case 'downloadModel':
+      return downloadModel(id, msg.url, msg.name);
+    case 'deleteModel':
+      return deleteModel(msg.name);
+    case 'llmLoadModel':
+      return unwrap(Module.llmLoadModel(msg.path));
+    case 'llmUnloadModel':
+      return unwrap(Module.llmUnloadModel(msg.handle));
+    case 'llmGenerate':
+      return generate(Module, id, msg);
+    case 'sttLoadModel':
+      return unwrap(Module.sttLoadModel(msg.path));
+    case 'sttUnloadModel':
+      return unwrap(Module.sttUnloadModel(msg.handle));
+    case 'sttTranscribe':
+      return transcribe(Module, msg);
+    case 'ttsLoadModel':
+      return unwrap(Module.ttsLoadModel(msg.path));
+    case 'ttsUnloadModel':
+      return unwrap(Module.ttsUnloadModel(msg.handle));
+    case 'ttsSynthesize':
+      return synthesize(Module, msg);
+    default:
+      throw new Error(`Unknown request: ${msg.type}`);
+  }
+}
+
+self.onmessage = async ({ data }) => {
+  const { id } = data;
+  try {
+    const value = await dispatch(id, data);
+    // Hand synthesized PCM to the page without copying
+    const transfer = value?.samples instanceof Float32Array ? [value.samples.buffer] : [];
+    self.postMessage({ id, value }, transfer);
+  } catch (e) {
+    self.postMessage({ id, error: { message: e.message, code: e.code ?? -1 } });
+  }
+};
@@ -0,0 +1,437 @@
+/**
+ * ondeviceai_wasm.cpp
+ * WebAssembly bindings (embind) over the C++ core.
+ *
+ * The module runs inside a dedicated Web Worker (js/ondeviceai.worker.js).
+ * Inference executes on one long-lived pthread, one request at a time, so
+ * the worker's event loop stays free and the pthread pool never runs dry;
+ * results are proxied back to the worker thread, which owns every JS value.
+ * Models live in OPFS and are opened by path through WasmFS under /opfs.
+ *
+ * Requirements: 7.3, 7.8
+ */
+
+#include "ondeviceai/sdk_manager.hpp"
+#include "ondeviceai/llm_engine.hpp"
+#include "ondeviceai/stt_engine.hpp"
+#include "ondeviceai/tts_engine.hpp"
+#include "ondeviceai/callback_dispatcher.hpp"
+#include "ondeviceai/types.hpp"
+
+#include "../../common/utf8_prefix.h"
+
+#include <emscripten/bind.h>
+#include <emscripten/proxying.h>
+#include <emscripten/val.h>
+#include <emscripten/wasmfs.h>
+
+#include <pthread.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace ondeviceai;
+using emscripten::val;
+
+namespace {
+
+constexpr const char* kOPFSMount = "/opfs";
+
+#ifndef ODAI_WASM_THREAD_POOL_SIZE
+#define ODAI_WASM_THREAD_POOL_SIZE 5
+#endif
+
+/// Pool workers left for the core once the inference thread is taken
+constexpr int kMaxComputeThreads = ODAI_WASM_THREAD_POOL_SIZE - 1;
+static_assert(kMaxComputeThreads >= 1, "PTHREAD_POOL_SIZE must leave room for compute threads");
+
+/// Queue used to run JS-facing work back on the worker thread
+emscripten::ProxyingQueue& proxyQueue() {
+    static emscripten::ProxyingQueue queue;
+    return queue;
+}
+
+/// JS callbacks of in-flight requests, keyed by request id.
+/// Only accessed on the worker thread.
+std::unordered_map<int, val>& pendingCallbacks() {
+    static std::unordered_map<int, val> callbacks;
+    return callbacks;
+}
+
+int g_next_request = 1;
+
+val errorObject(int code, const std::string& message) {
+    val obj = val::object();
+    obj.set("code", code);
+    obj.set("message", message);
+    return obj;
+}
+
+val errorObject(const Error& error) {
+    return errorObject(static_cast<int>(error.code), error.message);
+}
+
+/// { value } on success, { error } on failure
+template <typename T>
+val resultObject(const Result<T>& result) {
+    val obj = val::object();
+    if (result.isError()) {
+        obj.set("error", errorObject(result.error()));
+    } else {
+        obj.set("value", static_cast<double>(result.value()));
+    }
+    return obj;
+}
+
+template <typename R>
+val voidResultObject(const R& result) {
+    val obj = val::object();
+    if (result.isError()) obj.set("error", errorObject(result.error()));
+    return obj;
+}
+
+val notInitialized() {
+    val obj = val::object();
+    obj.set("error", errorObject(-2, "SDK not initialized"));
+    return obj;
+}
+
+/// Register `callbacks` and return the id used by worker-thread posts
+int registerRequest(val callbacks) {
+    int id = g_next_request++;
+    pendingCallbacks().emplace(id, std::move(callbacks));
+    return id;
+}
+
+/// Run `fn(callbacks)` on the worker thread; `finish` drops the request.
+template <typename Fn>
+void postToWorker(pthread_t worker, int id, bool finish, Fn fn) {
+    proxyQueue().proxyAsync(worker, [id, finish, fn = std::move(fn)]() mutable {
+        auto& callbacks = pendingCallbacks();
+        auto it = callbacks.find(id);
+        if (it == callbacks.end()) return;
+        fn(it->second);
+        if (finish) callbacks.erase(it);
+    });
+}
+
+using bridge::completeUtf8Prefix;
+
+/// Single inference thread fed by a FIFO of jobs. Spawning a std::thread
+/// per request would exhaust the fixed PTHREAD_POOL_SIZE and deadlock the
+/// worker, so every request runs here in submission order.
+class InferenceQueue {
+public:
+    void submit(std::function<void()> job) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!thread_.joinable()) {
+            thread_ = std::thread([this] { run(); });
+        }
+        jobs_.push_back(std::move(job));
+        ready_.notify_one();
+    }
+
+    /// Block until every submitted job has finished
+    void waitIdle() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_.wait(lock, [this] { return jobs_.empty() && !busy_; });
+    }
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            ready_.wait(lock, [this] { return !jobs_.empty(); });
+            auto job = std::move(jobs_.front());
+            jobs_.pop_front();
+            busy_ = true;
+            lock.unlock();
+            job();
+            lock.lock();
+            busy_ = false;
+            if (jobs_.empty()) idle_.notify_all();
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::condition_variable idle_;
+    std::deque<std::function<void()>> jobs_;
+    std::thread thread_;
+    bool busy_ = false;
+};
+
+/// Lives for the whole module; the thread is never joined
+InferenceQueue& inferenceQueue() {
+    static auto* queue = new InferenceQueue();
+    return *queue;
+}
+
+// ---------------------------------------------------------------------------
+// SDK
+// ---------------------------------------------------------------------------
+
+/// Mount origin-private storage at /opfs. Must be called from the worker.
+bool mountOPFS() {
+    static bool mounted = false;
+    if (mounted) return true;
+    backend_t opfs = wasmfs_create_opfs_backend();
+    mounted = opfs && wasmfs_create_directory(kOPFSMount, 0777, opfs) == 0;
+    return mounted;
+}
+
+val initialize(std::string modelDirectory, int threadCount, double memoryLimitBytes) {
+    SDKConfig config;
+    config.model_directory = std::move(modelDirectory);
+    config.thread_count    = std::clamp(threadCount, 1, kMaxComputeThreads);
+    config.memory_limit    = static_cast<size_t>(memoryLimitBytes);
+    config.log_level       = LogLevel::Info;
+    // Deliver tokens on the inference thread; results are proxied to the
+    // worker anyway, and dispatcher threads would need pool slots of their own
+    config.synchronous_callbacks = true;
+
+    auto result = SDKManager::initialize(config);
+    val obj = val::object();
+    if (result.isError()) obj.set("error", errorObject(result.error()));
+    return obj;
+}
+
+/// Waits for queued requests so no job outlives the engines it uses
+void shutdown() {
+    inferenceQueue().waitIdle();
+    SDKManager::shutdown();
+}
+
+// ---------------------------------------------------------------------------
+// LLM
+// ---------------------------------------------------------------------------
+
+val llmLoadModel(std::string path) {
+    auto* mgr = SDKManager::getInstance();
+    if (!mgr) return notInitialized();
+    return resultObject(mgr->getLLMEngine()->loadModel(path));
+}
+
+val llmUnloadModel(double handle) {
+    auto* mgr = SDKManager::getInstance();
+    if (!mgr) return notInitialized();
+    return voidResultObject(mgr->getLLMEngine()->unloadModel(static_cast<ModelHandle>(handle)));
+}
+
+/**
+ * Start streaming generation. `callbacks` is { onTokens(text), onDone(error?) };
+ * tokens are delivered `batchTokens` at a time.
+ */
+val llmGenerateStreaming(double handle, std::string prompt, val config, val callbacks, int batchTokens) {
+    auto* mgr = SDKManager::getInstance();
+    if (!mgr) return notInitialized();
+
+    GenerationConfig gCfg;
+    if (config.hasOwnProperty("temperature")) gCfg.temperature = config["temperature"].as<float>();
+    if (config.hasOwnProperty("topP")) gCfg.top_p = config["topP"].as<float>();
+    if (config.hasOwnProperty("maxTokens")) gCfg.max_tokens = config["maxTokens"].as<int>();
+
+    const int batch = std::max(1, batchTokens);
+    const int id = registerRequest(std::move(callbacks));
+    const pthread_t worker = pthread_self();
+
+    inferenceQueue().submit([handle, prompt = std::move(prompt), gCfg, batch, id, worker]() {
+        auto* mgr = SDKManager::getInstance();
+        if (!mgr) {
+            postToWorker(worker, id, true, [](val& cb) {
+                cb.call<void>("onDone", std::string("SDK not initialized"));
+            });
+            return;
+        }
+
+        // Batch state is shared with the token callback, which may run on a
+        // dispatcher thread if callbacks are configured asynchronous
+        struct Stream {
+            std::mutex mutex;
+            std::string pending;
+            int pending_tokens = 0;
+
+            // Caller holds `mutex`
+            void flush(pthread_t target, int request, bool force) {
+                size_t n = force ? pending.size() : completeUtf8Prefix(pending);
+                if (n == 0) return;
+                postToWorker(target, request, false, [text = pending.substr(0, n)](val& cb) {
+                    cb.call<void>("onTokens", text);
+                });
+                pending.erase(0, n);
+                pending_tokens = 0;
+            }
+        };
+        auto stream = std::make_shared<Stream>();
+
+        auto result = mgr->getLLMEngine()->generateStreaming(
+            static_cast<ModelHandle>(handle), prompt,
+            [stream, batch, id, worker](const std::string& token) {
+                std::lock_guard<std::mutex> lock(stream->mutex);
+                stream->pending += token;
+                if (++stream->pending_tokens >= batch) stream->flush(worker, id, false);
+            },
+            gCfg);
+
+        // onDone must be proxied after the last onTokens
+        mgr->getCallbackDispatcher()->waitForCompletion();
+        {
+            std::lock_guard<std::mutex> lock(stream->mutex);
+            stream->flush(worker, id, true);
+        }
+        std::string error = result.isError() ? result.error().message : std::string();
+        postToWorker(worker, id, true, [error = std::move(error)](val& cb) {
+            if (error.empty()) {
+                cb.call<void>("onDone");
+            } else {
+                cb.call<void>("onDone", error);
+            }
+        });
+    });
+
+    return val::object();
+}
+
+// ---------------------------------------------------------------------------
+// STT
+// ---------------------------------------------------------------------------
+
+val sttLoadModel(std::string path) {
+    auto* mgr = SDKManager::getInstance();
+    if (!mgr) return notInitialized();
+    return resultObject(mgr->getSTTEngine()->loadModel(path));
+}
+
+val sttUnloadModel(double handle) {
+    auto* mgr = SDKManager::getInstance();
+    if (!mgr) return notInitialized();
+    return voidResultObject(mgr->getSTTEngine()->unloadModel(static_cast<ModelHandle>(handle)));
+}
+
+/**
+ * Transcribe a Float32Array of mono PCM. `callbacks` is
+ * { onDone(text | null, error?) }.
+ */
+val sttTranscribe(double handle, val pcm, int sampleRate, val callbacks) {
+    auto* mgr = SDKManager::getInstance();
+    if (!mgr) return notInitialized();
+
+    // Single copy from the JS array into the WASM heap
+    AudioData audio;
+    audio.samples     = emscripten::convertJSArrayToNumberVector<float>(pcm);
+    audio.sample_rate = sampleRate;
+    audio.channels    = 1;
+
+    const int id = registerRequest(std::move(callbacks));
+    const pthread_t worker = pthread_self();
+
+    inferenceQueue().submit([handle, audio = std::move(audio), id, worker]() {
+        auto* mgr = SDKManager::getInstance();
+        if (!mgr) {
+            postToWorker(worker, id, true, [](val& cb) {
+                cb.call<void>("onDone", val::null(), std::string("SDK not initialized"));
+            });
+            return;
+        }
+        TranscriptionConfig tCfg;
+        auto result = mgr->getSTTEngine()->transcribe(static_cast<ModelHandle>(handle), audio, tCfg);
+        std::string text  = result.isError() ? std::string() : result.value().text;
+        std::string error = result.isError() ? result.error().message : std::string();
+        postToWorker(worker, id, true, [text = std::move(text), error = std::move(error)](val& cb) {
+            if (error.empty()) {
+                cb.call<void>("onDone", text);
+            } else {
+                cb.call<void>("onDone", val::null(), error);
+            }
+        });
+    });
+
+    return val::object();
+}
+
+// ---------------------------------------------------------------------------
+// TTS
+// ---------------------------------------------------------------------------
+
+val ttsLoadModel(std::string path) {
+    auto* mgr = SDKManager::getInstance();
+    if (!mgr) return notInitialized();
+    return resultObject(mgr->getTTSEngine()->loadModel(path));
+}
+
+val ttsUnloadModel(double handle) {
+    auto* mgr = SDKManager::getInstance();
+    if (!mgr) return notInitialized();
+    return voidResultObject(mgr->getTTSEngine()->unloadModel(static_cast<ModelHandle>(handle)));
+}
+
+/**
+ * Synthesize `text`. `callbacks` is { onDone(pcm | null, sampleRate, error?) };
+ * pcm is a Float32Array copied out of the shared heap so the worker can
+ * transfer it to the page without another copy.
+ */
+val ttsSynthesize(double handle, std::string text, val config, val callbacks) {
+    auto* mgr = SDKManager::getInstance();
+    if (!mgr) return notInitialized();
+
+    SynthesisConfig sCfg;
+    if (config.hasOwnProperty("speed")) sCfg.speed = config["speed"].as<float>();
+    if (config.hasOwnProperty("pitch")) sCfg.pitch = config["pitch"].as<float>();
+
+    const int id = registerRequest(std::move(callbacks));
+    const pthread_t worker = pthread_self();
+
+    inferenceQueue().submit([handle, text = std::move(text), sCfg, id, worker]() {
+        auto* mgr = SDKManager::getInstance();
+        if (!mgr) {
+            postToWorker(worker, id, true, [](val& cb) {
+                cb.call<void>("onDone", val::null(), 0, std::string("SDK not initialized"));
+            });
+            return;
+        }
+        auto result = mgr->getTTSEngine()->synthesize(static_cast<ModelHandle>(handle), text, sCfg);
+        if (result.isError()) {
+            postToWorker(worker, id, true, [error = result.error().message](val& cb) {
+                cb.call<void>("onDone", val::null(), 0, error);
+            });
+            return;
+        }
+        const int sampleRate = result.value().sample_rate;
+        postToWorker(worker, id, true,
+                     [samples = std::move(result.value().samples), sampleRate](val& cb) {
+            val view(emscripten::typed_memory_view(samples.size(), samples.data()));
+            cb.call<void>("onDone", view.call<val>("slice"), sampleRate);
+        });
+    });
+
+    return val::object();
+}
+
+} // namespace
+
+EMSCRIPTEN_BINDINGS(ondeviceai) {
+    emscripten::function("mountOPFS", &mountOPFS);
+    emscripten::function("initialize", &initialize);
+    emscripten::function("shutdown", &shutdown);
+
+    emscripten::function("llmLoadModel", &llmLoadModel);
+    emscripten::function("llmUnloadModel", &llmUnloadModel);
+    emscripten::function("llmGenerateStreaming", &llmGenerateStreaming);
+
+    emscripten::function("sttLoadModel", &sttLoadModel);
+    emscripten::function("sttUnloadModel", &sttUnloadModel);
+    emscripten::function("sttTranscribe", &sttTranscribe);
+
+    emscripten::function("ttsLoadModel", &ttsLoadModel);
+    emscripten::function("ttsUnloadModel", &ttsUnloadModel);
+    emscripten::function("ttsSynthesize", &ttsSynthesize);
+}
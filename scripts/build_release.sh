@@ -205,6 +205,13 @@ package_react_native() {
     # Copy all React Native files
     cp -r "${PROJECT_ROOT}/platforms/react-native/"* "${rn_out}/" 2>/dev/null || true
 
+    # The podspec vendors the core XCFramework from the iOS build
+    if [ -d "${ARTIFACTS_DIR}/ios/OnDeviceAI.xcframework" ]; then
+        cp -r "${ARTIFACTS_DIR}/ios/OnDeviceAI.xcframework" "${rn_out}/ios/"
+    else
+        log "OnDeviceAI.xcframework not built – run --platform ios first for the iOS pod"
+    fi
+
     # Install dependencies if npm available
     if command -v npm &>/dev/null && [ -f "${rn_out}/package.json" ]; then
         cd "${rn_out}"
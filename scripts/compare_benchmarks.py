@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+# ==============================================================================
+# OnDevice AI SDK — Benchmark Regression Gate
+# Compares Google Benchmark JSON output (ondeviceai_microbench) against a
+# stored baseline and exits non-zero when any metric regresses past the
+# threshold.
+#
+# Usage:
+#   scripts/compare_benchmarks.py BASELINE.json CURRENT.json [--threshold 0.10]
+#   scripts/compare_benchmarks.py BASELINE.json CURRENT.json --update
+# ==============================================================================
+
+import argparse
+import json
+import shutil
+import sys
+
+# User counters and whether a larger value is better
+COUNTER_DIRECTION = {
+    "tok_per_s": True,
+    "bytes_per_second": True,
+    "items_per_second": True,
+    "ttft_ms": False,
+    "rtf": False,
+}
+
+
+def load_results(path):
+    """Map benchmark name -> metrics, preferring median aggregates.
+
+    Also returns the names of benchmarks that errored or were skipped.
+    """
+    with open(path) as f:
+        data = json.load(f)
+
+    results = {}
+    medians = {}
+    errors = set()
+    for bench in data.get("benchmarks", []):
+        if bench.get("error_occurred"):
+            errors.add(bench.get("run_name", bench["name"]))
+            continue
+        if bench.get("run_type") == "aggregate":
+            if bench.get("aggregate_name") != "median":
+                continue
+            name = bench["run_name"]
+            medians[name] = bench
+        else:
+            results.setdefault(bench.get("run_name", bench["name"]), bench)
+    results.update(medians)
+    return results, errors - set(results)
+
+
+def metrics_of(bench):
+    metrics = {"real_time": (bench["real_time"], False)}
+    for key, higher_is_better in COUNTER_DIRECTION.items():
+        if key in bench:
+            metrics[key] = (bench[key], higher_is_better)
+    return metrics
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare benchmark JSON against a baseline")
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="allowed relative regression (default 0.10 = 10%%)")
+    parser.add_argument("--update", action="store_true",
+                        help="replace the baseline with the current results")
+    args = parser.parse_args()
+
+    if args.update:
+        shutil.copyfile(args.current, args.baseline)
+        print(f"Baseline updated: {args.baseline}")
+        return 0
+
+    baseline, _ = load_results(args.baseline)
+    current, current_errors = load_results(args.current)
+
+    regressions = []
+    print(f"{'benchmark':<48} {'metric':<16} {'baseline':>12} {'current':>12} {'change':>8}")
+    for name in sorted(current):
+        if name not in baseline:
+            print(f"{name:<48} {'(new)':<16}")
+            continue
+        base_metrics = metrics_of(baseline[name])
+        for metric, (value, higher_is_better) in metrics_of(current[name]).items():
+            if metric not in base_metrics or base_metrics[metric][0] == 0:
+                continue
+            base = base_metrics[metric][0]
+            change = (value - base) / base
+            regressed = -change > args.threshold if higher_is_better else change > args.threshold
+            flag = "  REGRESSION" if regressed else ""
+            print(f"{name:<48} {metric:<16} {base:>12.4g} {value:>12.4g} {change:>+7.1%}{flag}")
+            if regressed:
+                regressions.append((name, metric, change))
+
+    # A benchmark that stopped running (or now errors) must not pass silently
+    for name in sorted(set(baseline) - set(current)):
+        status = "(error)" if name in current_errors else "(missing)"
+        print(f"{name:<48} {status:<16}  REGRESSION")
+        regressions.append((name, status, None))
+
+    if regressions:
+        print(f"\n{len(regressions)} metric(s) regressed beyond {args.threshold:.0%} or went missing")
+        return 1
+    print(f"\nNo regressions beyond {args.threshold:.0%}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
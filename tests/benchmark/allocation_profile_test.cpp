@@ -0,0 +1,466 @@
+// ==============================================================================
+// OnDevice AI SDK — Allocation Profiling Mode
+//
+// Opt-in binary that replaces the global operator new/delete, so every C++
+// heap allocation made by the core (and by llama.cpp / whisper.cpp / ORT code
+// that allocates through operator new) is counted. Per operation phase it
+// records:
+//   - peak live bytes (process-wide, while the phase is active)
+//   - allocation count and bytes allocated
+//   - top call sites: a short backtrace is kept per allocation, and the
+//     report attributes it to the first ondeviceai:: frame above the
+//     allocator and std:: internals, so peaks point at SDK code
+//
+// Phases: llm_load, stt_load, tts_load, prefill, decode, transcribe,
+// synthesize, model_switch (LLM -> a second LLM, when bench-llm-alt.gguf
+// is present). Token callbacks run synchronously so the prefill/decode
+// split happens on the generating thread.
+// malloc-based allocators (ggml buffers, ORT arenas) are not intercepted;
+// their footprint shows up in MemoryManager accounting instead.
+//
+// Fixtures from $ONDEVICEAI_BENCH_MODELS (default ./models):
+//   bench-llm.gguf, bench-stt.bin, bench-tts.onnx, bench-speech.wav,
+//   bench-llm-alt.gguf (optional, a different LLM for model_switch)
+// Report: test_reports/allocation_profile.json
+// ==============================================================================
+
+#include <gtest/gtest.h>
+#include "ondeviceai/ondeviceai.hpp"
+#include "bench_fixtures.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <new>
+#include <string>
+#include <vector>
+
+#if defined(__GLIBC__) || defined(__APPLE__)
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#define ODAI_HAVE_DLADDR 1
+#define ODAI_HAVE_BACKTRACE 1
+#elif defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#define ODAI_HAVE_CAPTURE_STACK 1
+#endif
+
+using namespace ondeviceai;
+
+// =============================================================================
+// Allocation tracker
+// =============================================================================
+
+namespace alloc_profile {
+
+enum Phase {
+    LLMLoad, STTLoad, TTSLoad, Prefill, Decode, Transcribe, Synthesize, ModelSwitch, kPhaseCount
+};
+
+const char* const kPhaseNames[kPhaseCount] = {
+    "llm_load", "stt_load", "tts_load", "prefill", "decode", "transcribe", "synthesize",
+    "model_switch"};
+
+constexpr int kNoPhase = -1;
+constexpr size_t kSiteSlots = 2048;
+/// Frames kept per allocation; enough to climb out of allocator internals
+constexpr int kStackDepth = 16;
+
+/// Size prefix kept in front of every block so delete knows what it frees
+constexpr size_t kHeader = alignof(std::max_align_t);
+
+/// One distinct allocation stack. `frames` is written once by the thread
+/// that claims the slot and only read by the report.
+struct Site {
+    std::atomic<uint64_t> key{0};
+    std::atomic<int64_t> count{0};
+    std::atomic<int64_t> bytes{0};
+    std::atomic<bool> ready{false};
+    int depth = 0;
+    void* frames[kStackDepth] = {};
+};
+
+struct PhaseStats {
+    std::atomic<int64_t> peak_live{0};
+    std::atomic<int64_t> count{0};
+    std::atomic<int64_t> bytes{0};
+    Site sites[kSiteSlots];
+};
+
+std::atomic<int64_t> g_live{0};
+std::atomic<int> g_phase{kNoPhase};
+PhaseStats g_stats[kPhaseCount];
+
+void raisePeak(std::atomic<int64_t>& peak, int64_t value) {
+    int64_t prev = peak.load(std::memory_order_relaxed);
+    while (value > prev && !peak.compare_exchange_weak(prev, value, std::memory_order_relaxed)) {}
+}
+
+/// Return addresses of the current stack, innermost first; never allocates
+/// through operator new
+int captureStack(void** frames) {
+#if defined(ODAI_HAVE_BACKTRACE)
+    return backtrace(frames, kStackDepth);
+#elif defined(ODAI_HAVE_CAPTURE_STACK)
+    return static_cast<int>(CaptureStackBackTrace(0, kStackDepth, frames, nullptr));
+#else
+    (void)frames;
+    return 0;
+#endif
+}
+
+#if defined(ODAI_HAVE_BACKTRACE)
+/// glibc loads its unwinder on the first backtrace() call; do that before
+/// any phase is active so it is not charged to a profiled operation
+const bool g_unwinder_loaded = [] {
+    void* frame[1];
+    return backtrace(frame, 1) >= 0;
+}();
+#endif
+
+uint64_t hashStack(void* const* frames, int depth) {
+    uint64_t h = 1469598103934665603ULL;  // FNV-1a
+    for (int i = 0; i < depth; ++i) {
+        h ^= static_cast<uint64_t>(reinterpret_cast<uintptr_t>(frames[i]));
+        h *= 1099511628211ULL;
+    }
+    return h ? h : 1;
+}
+
+/// Lock-free open addressing on the stack hash; never allocates
+void recordSite(PhaseStats& stats, void* const* frames, int depth, int64_t size) {
+    const uint64_t key = hashStack(frames, depth);
+    size_t slot = static_cast<size_t>(key % kSiteSlots);
+    for (size_t probe = 0; probe < kSiteSlots; ++probe) {
+        Site& site = stats.sites[(slot + probe) % kSiteSlots];
+        uint64_t current = site.key.load(std::memory_order_relaxed);
+        if (current == 0 && site.key.compare_exchange_strong(current, key, std::memory_order_relaxed)) {
+            site.depth = depth;
+            std::copy(frames, frames + depth, site.frames);
+            site.ready.store(true, std::memory_order_release);
+            current = key;
+        }
+        if (current == key) {
+            site.count.fetch_add(1, std::memory_order_relaxed);
+            site.bytes.fetch_add(size, std::memory_order_relaxed);
+            return;
+        }
+    }
+}
+
+void* allocate(size_t size) {
+    void* block = std::malloc(size + kHeader);
+    if (!block) return nullptr;
+    *static_cast<size_t*>(block) = size;
+
+    int64_t live = g_live.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed) +
+                   static_cast<int64_t>(size);
+    int phase = g_phase.load(std::memory_order_relaxed);
+    if (phase != kNoPhase) {
+        PhaseStats& stats = g_stats[phase];
+        raisePeak(stats.peak_live, live);
+        stats.count.fetch_add(1, std::memory_order_relaxed);
+        stats.bytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed);
+        // The unwinder may allocate; those nested blocks are counted but not
+        // walked again
+        thread_local bool in_capture = false;
+        if (!in_capture) {
+            in_capture = true;
+            void* frames[kStackDepth];
+            int depth = captureStack(frames);
+            recordSite(stats, frames, depth, static_cast<int64_t>(size));
+            in_capture = false;
+        }
+    }
+    return static_cast<char*>(block) + kHeader;
+}
+
+void deallocate(void* ptr) {
+    if (!ptr) return;
+    void* block = static_cast<char*>(ptr) - kHeader;
+    g_live.fetch_sub(static_cast<int64_t>(*static_cast<size_t*>(block)), std::memory_order_relaxed);
+    std::free(block);
+}
+
+/// Make `phase` current; its peak starts from the live bytes at entry
+void enter(Phase phase) {
+    raisePeak(g_stats[phase].peak_live, g_live.load(std::memory_order_relaxed));
+    g_phase.store(phase, std::memory_order_relaxed);
+}
+
+void leave() {
+    g_phase.store(kNoPhase, std::memory_order_relaxed);
+}
+
+struct Frame {
+    std::string name;     // demangled symbol, or the address in hex
+    bool sdk = false;     // inside namespace ondeviceai
+    bool internal = false;  // allocator, std:: or profiler frame
+};
+
+Frame symbolize(void* address) {
+    Frame frame;
+#ifdef ODAI_HAVE_DLADDR
+    Dl_info info;
+    if (dladdr(address, &info) && info.dli_sname) {
+        int status = 0;
+        char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+        frame.name = status == 0 && demangled ? demangled : info.dli_sname;
+        std::free(demangled);
+    }
+#endif
+    if (frame.name.empty()) {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "0x%llx",
+                      static_cast<unsigned long long>(reinterpret_cast<uintptr_t>(address)));
+        frame.name = buf;
+        return frame;
+    }
+    auto startsWith = [&](const char* prefix) { return frame.name.rfind(prefix, 0) == 0; };
+    frame.internal = startsWith("std::") || startsWith("__gnu_cxx::") || startsWith("operator new") ||
+                     startsWith("alloc_profile::") || startsWith("void* std::") ||
+                     startsWith("__") || startsWith("backtrace");
+    frame.sdk = !frame.internal && frame.name.find("ondeviceai::") != std::string::npos;
+    return frame;
+}
+
+/// Name of the frame an allocation stack is charged to: the first SDK frame,
+/// else the first frame outside allocator and std:: internals
+std::string attributeSite(const Site& site) {
+    std::string fallback;
+    for (int i = 0; i < site.depth; ++i) {
+        Frame frame = symbolize(site.frames[i]);
+        if (frame.sdk) return frame.name;
+        if (!frame.internal && fallback.empty()) fallback = frame.name;
+    }
+    return fallback.empty() ? "(unknown)" : fallback;
+}
+
+struct SiteSummary {
+    std::string name;
+    int64_t count;
+    int64_t bytes;
+};
+
+std::vector<SiteSummary> topSites(const PhaseStats& stats, size_t limit) {
+    std::map<std::string, SiteSummary> merged;
+    for (const auto& site : stats.sites) {
+        if (!site.ready.load(std::memory_order_acquire)) continue;
+        std::string name = attributeSite(site);
+        auto& entry = merged.emplace(name, SiteSummary{name, 0, 0}).first->second;
+        entry.count += site.count.load();
+        entry.bytes += site.bytes.load();
+    }
+    std::vector<SiteSummary> sites;
+    for (auto& kv : merged) sites.push_back(std::move(kv.second));
+    std::sort(sites.begin(), sites.end(),
+              [](const SiteSummary& a, const SiteSummary& b) { return a.bytes > b.bytes; });
+    if (sites.size() > limit) sites.resize(limit);
+    return sites;
+}
+
+/// Scoped phase marker
+class ScopedPhase {
+public:
+    explicit ScopedPhase(Phase phase) { enter(phase); }
+    ~ScopedPhase() { leave(); }
+    ScopedPhase(const ScopedPhase&) = delete;
+    ScopedPhase& operator=(const ScopedPhase&) = delete;
+};
+
+} // namespace alloc_profile
+
+// Global replacements; aligned overloads keep the default implementation
+
+void* operator new(size_t size) {
+    void* p = alloc_profile::allocate(size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](size_t size) {
+    void* p = alloc_profile::allocate(size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return alloc_profile::allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return alloc_profile::allocate(size);
+}
+
+void operator delete(void* ptr) noexcept { alloc_profile::deallocate(ptr); }
+void operator delete[](void* ptr) noexcept { alloc_profile::deallocate(ptr); }
+void operator delete(void* ptr, size_t) noexcept { alloc_profile::deallocate(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { alloc_profile::deallocate(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { alloc_profile::deallocate(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { alloc_profile::deallocate(ptr); }
+
+// =============================================================================
+// Test fixture
+// =============================================================================
+
+class AllocationProfile : public ::testing::Test {
+protected:
+    static void SetUpTestSuite() {
+        // Synchronous callbacks: the decode phase is entered from the token
+        // callback, which must run on the generating thread
+        auto result = SDKManager::initialize(bench::sdkConfig());
+        if (result.isSuccess()) sdk_ = result.value();
+    }
+
+    static void TearDownTestSuite() {
+        SDKManager::shutdown();
+        sdk_ = nullptr;
+    }
+
+    static SDKManager* sdk_;
+};
+
+SDKManager* AllocationProfile::sdk_ = nullptr;
+
+TEST_F(AllocationProfile, LLMLoadPrefillDecode) {
+    using namespace alloc_profile;
+    const std::string path = bench::fixturePath("bench-llm.gguf");
+    if (!sdk_ || !bench::fileExists(path)) GTEST_SKIP() << "bench-llm.gguf fixture not found";
+    auto* llm = sdk_->getLLMEngine();
+
+    Result<ModelHandle> load = [&]() {
+        ScopedPhase phase(LLMLoad);
+        return llm->loadModel(path);
+    }();
+    if (load.isError()) GTEST_SKIP() << load.error().message;
+
+    GenerationConfig config;
+    config.max_tokens = 64;
+
+    // Prefill until the first token arrives, decode afterwards
+    enter(Prefill);
+    std::atomic<bool> first{true};
+    auto result = llm->generateStreaming(load.value(),
+        "Summarize why peak memory matters on mobile devices.",
+        [&](const std::string& /*token*/) {
+            if (first.exchange(false)) enter(Decode);
+        }, config);
+    leave();
+    EXPECT_TRUE(result.isSuccess());
+
+    // Switch to a different model, as happens when the app changes LLMs.
+    // Reloading the same file would mostly measure warm caches.
+    const std::string alt_path = bench::fixturePath("bench-llm-alt.gguf");
+    if (!bench::fileExists(alt_path)) {
+        llm->unloadModel(load.value());
+        std::cout << "[BENCH] model_switch skipped: bench-llm-alt.gguf fixture not found\n";
+        return;
+    }
+    Result<ModelHandle> next = [&]() {
+        ScopedPhase phase(ModelSwitch);
+        llm->unloadModel(load.value());
+        return llm->loadModel(alt_path);
+    }();
+    EXPECT_TRUE(next.isSuccess());
+    if (next.isSuccess()) llm->unloadModel(next.value());
+}
+
+TEST_F(AllocationProfile, Transcribe) {
+    using namespace alloc_profile;
+    const std::string model = bench::fixturePath("bench-stt.bin");
+    const std::string speech = bench::fixturePath("bench-speech.wav");
+    if (!sdk_ || !bench::fileExists(model) || !bench::fileExists(speech)) {
+        GTEST_SKIP() << "bench-stt.bin / bench-speech.wav fixtures not found";
+    }
+    auto* stt = sdk_->getSTTEngine();
+    auto audio = AudioData::fromFile(speech);
+    if (audio.isError()) GTEST_SKIP() << audio.error().message;
+    Result<ModelHandle> load = [&]() {
+        ScopedPhase phase(STTLoad);
+        return stt->loadModel(model);
+    }();
+    if (load.isError()) GTEST_SKIP() << load.error().message;
+
+    {
+        ScopedPhase phase(Transcribe);
+        auto result = stt->transcribe(load.value(), audio.value());
+        EXPECT_TRUE(result.isSuccess());
+    }
+    stt->unloadModel(load.value());
+}
+
+TEST_F(AllocationProfile, Synthesize) {
+    using namespace alloc_profile;
+    const std::string model = bench::fixturePath("bench-tts.onnx");
+    if (!sdk_ || !bench::fileExists(model)) GTEST_SKIP() << "bench-tts.onnx fixture not found";
+    auto* tts = sdk_->getTTSEngine();
+    Result<ModelHandle> load = [&]() {
+        ScopedPhase phase(TTSLoad);
+        return tts->loadModel(model);
+    }();
+    if (load.isError()) GTEST_SKIP() << load.error().message;
+
+    {
+        ScopedPhase phase(Synthesize);
+        auto result = tts->synthesize(load.value(), "Peak memory is what gets apps killed.");
+        EXPECT_TRUE(result.isSuccess());
+    }
+    tts->unloadModel(load.value());
+}
+
+// =============================================================================
+// Report generation (runs after all profiles)
+// =============================================================================
+
+class AllocationReportGenerator : public ::testing::Environment {
+public:
+    void TearDown() override {
+        using namespace alloc_profile;
+        leave();
+
+        std::ofstream report("test_reports/allocation_profile.json");
+        if (report.is_open()) report << "{\n  \"phases\": {\n";
+        bool first_phase = true;
+
+        for (int p = 0; p < kPhaseCount; ++p) {
+            const PhaseStats& stats = g_stats[p];
+            if (stats.count.load() == 0) continue;
+
+            const double peak_mb = stats.peak_live.load() / (1024.0 * 1024.0);
+            const double alloc_mb = stats.bytes.load() / (1024.0 * 1024.0);
+            printf("[BENCH] alloc %-13s peak_live=%8.2fMB allocs=%-9lld allocated=%8.2fMB\n",
+                   kPhaseNames[p], peak_mb, static_cast<long long>(stats.count.load()), alloc_mb);
+
+            auto sites = topSites(stats, 10);
+            for (const auto& site : sites) {
+                printf("[BENCH]     %10lld allocs %10.2fMB  %s\n", static_cast<long long>(site.count),
+                       site.bytes / (1024.0 * 1024.0), site.name.c_str());
+            }
+
+            if (!report.is_open()) continue;
+            report << (first_phase ? "" : ",\n") << "    \"" << kPhaseNames[p] << "\": {"
+                   << "\"peak_live_bytes\": " << stats.peak_live.load()
+                   << ", \"allocations\": " << stats.count.load()
+                   << ", \"allocated_bytes\": " << stats.bytes.load() << ", \"top_sites\": [";
+            for (size_t i = 0; i < sites.size(); ++i) {
+                std::string name = sites[i].name;
+                std::replace(name.begin(), name.end(), '"', '\'');
+                report << (i ? ", " : "") << "{\"site\": \"" << name
+                       << "\", \"allocations\": " << sites[i].count
+                       << ", \"bytes\": " << sites[i].bytes << "}";
+            }
+            report << "]}";
+            first_phase = false;
+        }
+        if (report.is_open()) report << "\n  }\n}\n";
+    }
+};
+
+static auto* allocation_report_env =
+    ::testing::AddGlobalTestEnvironment(new AllocationReportGenerator);
@@ -0,0 +1,54 @@
+// ==============================================================================
+// OnDevice AI SDK — Shared benchmark fixtures
+//
+// Fixture lookup and SDK configuration used by every benchmark target.
+// Fixtures are read from $ONDEVICEAI_BENCH_MODELS (default ./models):
+//   bench-llm.gguf, bench-stt.bin, bench-tts.onnx, bench-speech.wav
+// ==============================================================================
+
+#pragma once
+
+#include "ondeviceai/ondeviceai.hpp"
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+namespace bench {
+
+/// Value of environment variable `name`, or `fallback` when unset or empty
+inline std::string envOr(const char* name, const std::string& fallback) {
+    const char* value = std::getenv(name);
+    return value && *value ? value : fallback;
+}
+
+inline long envLong(const char* name, long fallback) {
+    const char* value = std::getenv(name);
+    return value && *value ? std::strtol(value, nullptr, 10) : fallback;
+}
+
+inline std::string modelsDir() {
+    return envOr("ONDEVICEAI_BENCH_MODELS", "./models");
+}
+
+inline std::string fixturePath(const char* name) {
+    return modelsDir() + "/" + name;
+}
+
+inline bool fileExists(const std::string& path) {
+    std::ifstream f(path);
+    return f.good();
+}
+
+/// SDK configuration for benchmarks: fixtures directory as the model
+/// directory, quiet logging, and synchronous callbacks
+inline ondeviceai::SDKConfig sdkConfig() {
+    auto config = ondeviceai::SDKConfig::defaults();
+    config.model_directory = modelsDir();
+    config.log_level = ondeviceai::LogLevel::Warning;
+    // Token callbacks must run on the generating thread, or the timestamps
+    // and phase markers they record race with the end-of-generation reads
+    config.synchronous_callbacks = true;
+    return config;
+}
+
+} // namespace bench
@@ -0,0 +1,308 @@
+// ==============================================================================
+// OnDevice AI SDK — Micro/Macro Benchmark Suite (Google Benchmark)
+//
+// Microbenchmarks (synthetic, seeded inputs; no models required):
+//   - Audio resampling, VAD, SHA-256, registry JSON parsing
+//   - CallbackDispatcher dispatch, MemoryManager hot path
+//
+// Macrobenchmarks (skipped when the fixture is missing):
+//   - LLM time-to-first-token and decode tok/s   (tiny GGUF)
+//   - STT real-time factor                        (whisper tiny)
+//   - TTS real-time factor                        (Piper voice)
+//
+// Fixtures are read from $ONDEVICEAI_BENCH_MODELS (default ./models):
+//   bench-llm.gguf, bench-stt.bin, bench-tts.onnx, bench-speech.wav
+//
+// Run with JSON output and compare against a stored baseline:
+//   ondeviceai_microbench --benchmark_repetitions=5 \
+//       --benchmark_out=bench.json --benchmark_out_format=json
+//   scripts/compare_benchmarks.py baseline.json bench.json --threshold 0.10
+// ==============================================================================
+
+#include <benchmark/benchmark.h>
+#include "ondeviceai/ondeviceai.hpp"
+#include "ondeviceai/callback_dispatcher.hpp"
+#include "ondeviceai/json_utils.hpp"
+#include "ondeviceai/sha256.hpp"
+#include "bench_fixtures.h"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace ondeviceai;
+using Clock = std::chrono::steady_clock;
+
+// =============================================================================
+// Fixtures
+// =============================================================================
+
+namespace {
+
+/// Deterministic tone + noise so every run processes identical samples
+AudioData syntheticAudio(int sample_rate, double seconds) {
+    AudioData audio;
+    audio.sample_rate = sample_rate;
+    audio.channels = 1;
+    audio.samples.resize(static_cast<size_t>(sample_rate * seconds));
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> noise(-0.01f, 0.01f);
+    for (size_t i = 0; i < audio.samples.size(); ++i) {
+        // Alternate half-second bursts of "speech" and near-silence
+        bool voiced = (i / (sample_rate / 2)) % 2 == 0;
+        float tone = voiced ? 0.2f * std::sin(2.0f * 3.14159f * 220.0f * i / sample_rate) : 0.0f;
+        audio.samples[i] = tone + noise(rng);
+    }
+    return audio;
+}
+
+std::map<std::string, ModelInfo> syntheticRegistry(int entries) {
+    const ModelType types[] = {ModelType::LLM, ModelType::STT, ModelType::TTS};
+    std::map<std::string, ModelInfo> registry;
+    for (int i = 0; i < entries; ++i) {
+        ModelInfo info;
+        // One id per entry: the registry is keyed by id
+        info.id = "model-" + std::to_string(i / 5) + "-v" + std::to_string(i % 5);
+        info.name = "Benchmark Model " + std::to_string(i / 5);
+        info.type = types[i % 3];
+        info.version = "1." + std::to_string(i % 5) + ".0";
+        info.size_bytes = (100ULL + i) * 1024 * 1024;
+        info.download_url = "https://example.com/models/" + info.id + "/" + info.version + "/model.bin";
+        info.checksum_sha256 = std::string(64, 'a' + static_cast<char>(i % 6));
+        info.metadata["architecture"] = "transformer";
+        info.metadata["quantization"] = "q4_0";
+        info.requirements.min_ram_bytes = 2ULL * 1024 * 1024 * 1024;
+        info.requirements.min_storage_bytes = info.size_bytes;
+        info.requirements.supported_platforms = {"iOS", "Android", "Linux", "macOS", "Windows"};
+        registry[info.id] = info;
+    }
+    return registry;
+}
+
+/// SDK shared by the macrobenchmarks, initialized on first use
+SDKManager* benchSDK() {
+    static SDKManager* sdk = []() -> SDKManager* {
+        auto result = SDKManager::initialize(bench::sdkConfig());
+        return result.isSuccess() ? result.value() : nullptr;
+    }();
+    return sdk;
+}
+
+} // namespace
+
+// =============================================================================
+// Microbenchmarks
+// =============================================================================
+
+static void BM_Resample(benchmark::State& state) {
+    AudioData audio = syntheticAudio(static_cast<int>(state.range(0)), 1.0);
+    for (auto _ : state) {
+        auto result = audio.resample(16000);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(audio.samples.size()));
+}
+BENCHMARK(BM_Resample)->Arg(8000)->Arg(44100)->Arg(48000);
+
+static void BM_VoiceActivityDetection(benchmark::State& state) {
+    STTEngine engine;
+    AudioData audio = syntheticAudio(16000, static_cast<double>(state.range(0)));
+    for (auto _ : state) {
+        auto result = engine.detectVoiceActivity(audio);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(audio.samples.size()));
+}
+BENCHMARK(BM_VoiceActivityDetection)->Arg(1)->Arg(10)->Unit(benchmark::kMicrosecond);
+
+static void BM_SHA256(benchmark::State& state) {
+    std::vector<uint8_t> data(static_cast<size_t>(state.range(0)));
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>((i * 2654435761u) >> 24);
+    }
+    for (auto _ : state) {
+        auto hash = crypto::SHA256::hash(data.data(), data.size());
+        benchmark::DoNotOptimize(hash);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SHA256)->Arg(64 << 10)->Arg(1 << 20)->Arg(16 << 20)->Unit(benchmark::kMicrosecond);
+
+static void BM_RegistryParse(benchmark::State& state) {
+    std::string json = json::serialize_model_registry(syntheticRegistry(static_cast<int>(state.range(0))));
+    for (auto _ : state) {
+        auto result = json::deserialize_model_registry(json);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(json.size()));
+}
+BENCHMARK(BM_RegistryParse)->Arg(10)->Arg(500)->Unit(benchmark::kMicrosecond);
+
+static void BM_CallbackDispatch(benchmark::State& state) {
+    CallbackConfig config;
+    config.mode = CallbackConfig::DispatchMode::Asynchronous;
+    config.callback_thread_count = static_cast<int>(state.range(0));
+    CallbackDispatcher dispatcher(config);
+
+    const int batch = 1000;
+    for (auto _ : state) {
+        for (int i = 0; i < batch; ++i) {
+            dispatcher.dispatch([]() {});
+        }
+        dispatcher.waitForCompletion();
+    }
+    state.SetItemsProcessed(state.iterations() * batch);
+}
+BENCHMARK(BM_CallbackDispatch)->Arg(1)->Arg(4)->Unit(benchmark::kMicrosecond);
+
+static void BM_MemoryManagerHotPath(benchmark::State& state) {
+    static MemoryManager* manager = nullptr;
+    const int num_models = 8;
+    if (state.thread_index() == 0) {
+        manager = new MemoryManager(0);
+        for (int m = 1; m <= num_models; ++m) {
+            manager->trackAllocation(m, 1024 * 1024);
+        }
+    }
+
+    int i = state.thread_index();
+    for (auto _ : state) {
+        auto handle = static_cast<ModelHandle>(1 + i++ % num_models);
+        manager->incrementRefCount(handle);
+        manager->recordAccess(handle);
+        manager->decrementRefCount(handle);
+    }
+    state.SetItemsProcessed(state.iterations() * 3);
+
+    if (state.thread_index() == 0) {
+        delete manager;
+        manager = nullptr;
+    }
+}
+BENCHMARK(BM_MemoryManagerHotPath)->Threads(1)->Threads(4)->Threads(16)->UseRealTime();
+
+// =============================================================================
+// Macrobenchmarks
+// =============================================================================
+
+static void BM_LLMGeneration(benchmark::State& state) {
+    const std::string path = bench::fixturePath("bench-llm.gguf");
+    auto* sdk = benchSDK();
+    if (!sdk || !bench::fileExists(path)) {
+        state.SkipWithError("bench-llm.gguf fixture not found");
+        return;
+    }
+    auto* llm = sdk->getLLMEngine();
+    auto load = llm->loadModel(path);
+    if (load.isError()) {
+        state.SkipWithError(load.error().message.c_str());
+        return;
+    }
+    auto handle = load.value();
+
+    GenerationConfig config;
+    config.max_tokens = 64;
+    config.temperature = 0.0f;
+    const std::string prompt = "Explain in one paragraph why on-device inference matters.";
+
+    double ttft_ms_total = 0.0;
+    double decode_tps_total = 0.0;
+    int runs = 0;
+
+    for (auto _ : state) {
+        llm->clearContext(handle);
+        int tokens = 0;
+        Clock::time_point first;
+        auto start = Clock::now();
+        auto result = llm->generateStreaming(handle, prompt,
+            [&](const std::string& /*token*/) {
+                if (tokens++ == 0) first = Clock::now();
+            }, config);
+        auto end = Clock::now();
+        if (result.isError() || tokens == 0) {
+            state.SkipWithError("generation produced no tokens");
+            break;
+        }
+        ttft_ms_total += std::chrono::duration<double, std::milli>(first - start).count();
+        double decode_s = std::chrono::duration<double>(end - first).count();
+        if (tokens > 1 && decode_s > 0.0) decode_tps_total += (tokens - 1) / decode_s;
+        ++runs;
+    }
+
+    if (runs > 0) {
+        state.counters["ttft_ms"] = ttft_ms_total / runs;
+        state.counters["tok_per_s"] = decode_tps_total / runs;
+    }
+    llm->unloadModel(handle);
+}
+BENCHMARK(BM_LLMGeneration)->Unit(benchmark::kMillisecond)->Iterations(5);
+
+static void BM_STTRealTimeFactor(benchmark::State& state) {
+    const std::string model = bench::fixturePath("bench-stt.bin");
+    const std::string speech = bench::fixturePath("bench-speech.wav");
+    auto* sdk = benchSDK();
+    if (!sdk || !bench::fileExists(model) || !bench::fileExists(speech)) {
+        state.SkipWithError("bench-stt.bin / bench-speech.wav fixtures not found");
+        return;
+    }
+    auto audio = AudioData::fromFile(speech);
+    if (audio.isError()) {
+        state.SkipWithError(audio.error().message.c_str());
+        return;
+    }
+    auto* stt = sdk->getSTTEngine();
+    auto load = stt->loadModel(model);
+    if (load.isError()) {
+        state.SkipWithError(load.error().message.c_str());
+        return;
+    }
+    const double audio_s = static_cast<double>(audio.value().samples.size()) / audio.value().sample_rate;
+
+    double elapsed_s = 0.0;
+    for (auto _ : state) {
+        auto start = Clock::now();
+        auto result = stt->transcribe(load.value(), audio.value());
+        elapsed_s += std::chrono::duration<double>(Clock::now() - start).count();
+        benchmark::DoNotOptimize(result);
+    }
+    state.counters["rtf"] = audio_s > 0.0 ? (elapsed_s / state.iterations()) / audio_s : 0.0;
+    stt->unloadModel(load.value());
+}
+BENCHMARK(BM_STTRealTimeFactor)->Unit(benchmark::kMillisecond)->Iterations(3);
+
+static void BM_TTSRealTimeFactor(benchmark::State& state) {
+    const std::string model = bench::fixturePath("bench-tts.onnx");
+    auto* sdk = benchSDK();
+    if (!sdk || !bench::fileExists(model)) {
+        state.SkipWithError("bench-tts.onnx fixture not found");
+        return;
+    }
+    auto* tts = sdk->getTTSEngine();
+    auto load = tts->loadModel(model);
+    if (load.isError()) {
+        state.SkipWithError(load.error().message.c_str());
+        return;
+    }
+    const std::string text = "The quick brown fox jumps over the lazy dog, twice, for good measure.";
+
+    double elapsed_s = 0.0;
+    double audio_s = 0.0;
+    for (auto _ : state) {
+        auto start = Clock::now();
+        auto result = tts->synthesize(load.value(), text);
+        elapsed_s += std::chrono::duration<double>(Clock::now() - start).count();
+        if (result.isSuccess() && result.value().sample_rate > 0) {
+            audio_s += static_cast<double>(result.value().samples.size()) / result.value().sample_rate;
+        }
+    }
+    state.counters["rtf"] = audio_s > 0.0 ? elapsed_s / audio_s : 0.0;
+    tts->unloadModel(load.value());
+}
+BENCHMARK(BM_TTSRealTimeFactor)->Unit(benchmark::kMillisecond)->Iterations(3);
+
+BENCHMARK_MAIN();
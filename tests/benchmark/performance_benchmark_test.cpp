@@ -5,22 +5,31 @@
 // Benchmarks:
 //   - Model loading times (target: < 2 seconds)
 //   - LLM inference speed (target: 50-100 tokens/sec for 7B model)
+//   - LLM prefill vs decode throughput (reported separately)
 //   - STT transcription throughput
 //   - TTS synthesis throughput
 //   - Memory usage under load (target: < 500MB with model loaded)
 //   - Concurrent operation overhead
+//   - MemoryManager hot-path contention at 1, 4 and 16 threads
+//   - SHA-256 verification throughput (MB/s)
+//   - Model registry JSON parsing (500-model registry)
 // ==============================================================================
 
 #include <gtest/gtest.h>
 #include "ondeviceai/ondeviceai.hpp"
+#include "ondeviceai/callback_dispatcher.hpp"
+#include "ondeviceai/sha256.hpp"
+#include "ondeviceai/json_utils.hpp"
 #include <chrono>
 #include <numeric>
 #include <fstream>
 #include <sstream>
 #include <cmath>
+#include <cstdio>
 #include <thread>
 #include <atomic>
 #include <algorithm>
+#include <map>
 
 using namespace ondeviceai;
 using Clock = std::chrono::high_resolution_clock;
@@ -160,6 +169,94 @@ TEST_F(PerformanceBenchmark, SDKInitializationTime) {
               << "ms (target: < 100ms)\n";
 }
 
+TEST_F(PerformanceBenchmark, SDKStartupPhaseBreakdown) {
+    // Splits cold start into initialize() and the first access of each
+    // component, so deferred construction shows up where it is paid.
+    BenchmarkTimer init_timer;
+    BenchmarkTimer model_manager_timer;
+    BenchmarkTimer memory_manager_timer;
+    BenchmarkTimer llm_timer;
+    BenchmarkTimer stt_timer;
+    BenchmarkTimer tts_timer;
+    BenchmarkTimer pipeline_timer;
+    BenchmarkTimer shutdown_timer;
+    const int iterations = 10;
+
+    // The loop shuts the suite fixture's SDK down; bring it back on every
+    // exit path (including a failed ASSERT) for the remaining benchmarks
+    struct RestoreSuiteSDK {
+        ~RestoreSuiteSDK() {
+            SDKManager::shutdown();
+            auto config = SDKConfig::defaults();
+            config.model_directory = "./models";
+            config.log_level = LogLevel::Warning;
+            auto restored = SDKManager::initialize(config);
+            sdk_ = restored.isSuccess() ? restored.value() : nullptr;
+        }
+    } restore_sdk;
+    sdk_ = nullptr;
+
+    for (int i = 0; i < iterations; ++i) {
+        SDKManager::shutdown();
+
+        auto config = SDKConfig::defaults();
+        config.model_directory = "./models";
+        config.log_level = LogLevel::Warning;
+
+        init_timer.start();
+        auto result = SDKManager::initialize(config);
+        init_timer.stop();
+        ASSERT_TRUE(result.isSuccess());
+        auto* sdk = result.value();
+
+        model_manager_timer.start();
+        EXPECT_NE(sdk->getModelManager(), nullptr);
+        model_manager_timer.stop();
+
+        memory_manager_timer.start();
+        EXPECT_NE(sdk->getMemoryManager(), nullptr);
+        memory_manager_timer.stop();
+
+        llm_timer.start();
+        EXPECT_NE(sdk->getLLMEngine(), nullptr);
+        llm_timer.stop();
+
+        stt_timer.start();
+        EXPECT_NE(sdk->getSTTEngine(), nullptr);
+        stt_timer.stop();
+
+        tts_timer.start();
+        EXPECT_NE(sdk->getTTSEngine(), nullptr);
+        tts_timer.stop();
+
+        pipeline_timer.start();
+        EXPECT_NE(sdk->getVoicePipeline(), nullptr);
+        pipeline_timer.stop();
+
+        shutdown_timer.start();
+        SDKManager::shutdown();
+        shutdown_timer.stop();
+    }
+
+    std::cout << "[BENCH] SDK startup breakdown (median ms):"
+              << " initialize=" << init_timer.median()
+              << " model_manager=" << model_manager_timer.median()
+              << " memory_manager=" << memory_manager_timer.median()
+              << " llm=" << llm_timer.median()
+              << " stt=" << stt_timer.median()
+              << " tts=" << tts_timer.median()
+              << " voice_pipeline=" << pipeline_timer.median()
+              << " shutdown=" << shutdown_timer.median() << "\n";
+
+    double first_use = model_manager_timer.median() + memory_manager_timer.median() +
+                       llm_timer.median() + stt_timer.median() + tts_timer.median() +
+                       pipeline_timer.median();
+    record_benchmark("Startup: initialize()", init_timer, init_timer.median() < 100.0, "< 100ms");
+    record_benchmark("Startup: shutdown()", shutdown_timer, shutdown_timer.median() < 100.0, "< 100ms");
+    std::cout << "[BENCH] SDK cold start to all components ready: "
+              << init_timer.median() + first_use << "ms\n";
+}
+
 // =============================================================================
 // 22.2.2  Model Loading Time Benchmark
 // =============================================================================
@@ -323,6 +420,132 @@ TEST_F(PerformanceBenchmark, LLMInferenceSpeed) {
         ">= 50 tok/s (7B), >= 20 tok/s (CI)"});
 }
 
+TEST_F(PerformanceBenchmark, LLMPrefillVsDecodeThroughput) {
+    if (!sdk_) { GTEST_SKIP() << "SDK not initialized"; }
+
+    auto* llm = sdk_->getLLMEngine();
+    ASSERT_NE(llm, nullptr);
+
+    std::string model_path;
+    for (const auto& path : {
+        "./models/tinyllama-1.1b-chat-v1.0.Q4_K_M.gguf",
+        "./models/phi-2.Q4_K_M.gguf",
+        "./models/test-model.gguf"
+    }) {
+        std::ifstream f(path);
+        if (f.good()) { model_path = path; break; }
+    }
+
+    if (model_path.empty()) {
+        GTEST_SKIP() << "No model file found for prefill/decode benchmark.";
+    }
+
+    auto load_result = llm->loadModel(model_path);
+    if (load_result.isError()) {
+        GTEST_SKIP() << "Failed to load model: " << load_result.error().message;
+    }
+    auto handle = load_result.value();
+
+    // Deliver tokens on the generating thread so every timestamp is taken
+    // before generateStreaming returns; restored when the test exits.
+    auto* dispatcher = sdk_->getCallbackDispatcher();
+    const bool was_synchronous = dispatcher && dispatcher->isSynchronous();
+    sdk_->setSynchronousCallbacks(true);
+    struct RestoreDispatch {
+        SDKManager* sdk;
+        bool synchronous;
+        ~RestoreDispatch() { sdk->setSynchronousCallbacks(synchronous); }
+    } restore_dispatch{sdk_, was_synchronous};
+
+    // RAG-style long prompt so prefill dominates time-to-first-token
+    std::string prompt = "Use the following context to answer the question.\n";
+    for (int i = 0; i < 40; ++i) {
+        prompt += "Context passage " + std::to_string(i) +
+                  ": On-device inference keeps user data local, avoids network "
+                  "latency and works offline, at the cost of limited memory.\n";
+    }
+    prompt += "Question: Summarize the trade-offs of on-device inference.\nAnswer:";
+
+    auto tokens = llm->tokenize(handle, prompt);
+    if (tokens.isError()) {
+        llm->unloadModel(handle);
+        GTEST_SKIP() << "Tokenization failed: " << tokens.error().message;
+    }
+    const size_t prompt_tokens = tokens.value().size();
+
+    GenerationConfig config;
+    config.max_tokens = 64;
+    config.temperature = 0.7f;
+
+    std::vector<double> prefill_tps;
+    std::vector<double> decode_tps;
+
+    for (int i = 0; i < 3; ++i) {
+        // Start from an empty KV cache so every iteration pays the full prefill
+        llm->clearContext(handle);
+
+        std::atomic<int> token_count{0};
+        std::atomic<Clock::rep> first_token_ticks{0};
+        std::atomic<Clock::rep> last_token_ticks{0};
+        auto start = Clock::now();
+
+        auto result = llm->generateStreaming(handle, prompt,
+            [&](const std::string& /*token*/) {
+                const Clock::rep now = Clock::now().time_since_epoch().count();
+                if (token_count.fetch_add(1) == 0) {
+                    first_token_ticks.store(now);
+                }
+                last_token_ticks.store(now);
+            }, config);
+
+        if (dispatcher) dispatcher->waitForCompletion();
+        const int generated = token_count.load();
+        if (result.isError() || generated == 0) continue;
+
+        // Time to first token approximates prefill; first to last token is decode
+        const Clock::time_point first_token_time{Clock::duration(first_token_ticks.load())};
+        const Clock::time_point last_token_time{Clock::duration(last_token_ticks.load())};
+        double prefill_sec = std::chrono::duration<double>(first_token_time - start).count();
+        double decode_sec = std::chrono::duration<double>(last_token_time - first_token_time).count();
+
+        if (prefill_sec > 0.0) {
+            prefill_tps.push_back(prompt_tokens / prefill_sec);
+        }
+        if (generated > 1 && decode_sec > 0.0) {
+            decode_tps.push_back((generated - 1) / decode_sec);
+        }
+    }
+
+    llm->unloadModel(handle);
+
+    if (prefill_tps.empty()) {
+        GTEST_SKIP() << "Generation produced no tokens";
+    }
+
+    auto average = [](const std::vector<double>& v) {
+        return v.empty() ? 0.0 : std::accumulate(v.begin(), v.end(), 0.0) / v.size();
+    };
+    double avg_prefill = average(prefill_tps);
+    double avg_decode = average(decode_tps);
+
+    std::cout << "[BENCH] LLM Prefill: " << avg_prefill << " tokens/sec over "
+              << prompt_tokens << " prompt tokens\n";
+    std::cout << "[BENCH] LLM Decode: " << avg_decode << " tokens/sec\n";
+
+    // Prefill is batched and should always outrun single-token decode
+    bool meets = avg_prefill > avg_decode;
+    g_results.push_back({"LLM Prefill Throughput", avg_prefill, avg_prefill,
+        *std::min_element(prefill_tps.begin(), prefill_tps.end()),
+        *std::max_element(prefill_tps.begin(), prefill_tps.end()),
+        0.0, static_cast<int>(prefill_tps.size()), meets,
+        "prefill tok/s > decode tok/s"});
+    g_results.push_back({"LLM Decode Throughput", avg_decode, avg_decode,
+        decode_tps.empty() ? 0 : *std::min_element(decode_tps.begin(), decode_tps.end()),
+        decode_tps.empty() ? 0 : *std::max_element(decode_tps.begin(), decode_tps.end()),
+        0.0, static_cast<int>(decode_tps.size()), avg_decode >= 20.0,
+        ">= 20 tok/s (CI)"});
+}
+
 // =============================================================================
 // 22.2.4  Memory Usage Benchmark
 // =============================================================================
@@ -477,6 +700,165 @@ TEST_F(PerformanceBenchmark, ConcurrentMemoryQueries) {
         "> 100k queries/sec"});
 }
 
+TEST_F(PerformanceBenchmark, MemoryManagerHotPathContention) {
+    // recordAccess / incrementRefCount / decrementRefCount run on every
+    // inference call; measure how their throughput scales with threads.
+    const int num_models = 8;
+    const int ops_per_thread = 20000;
+    std::vector<double> qps_by_threads;
+
+    for (int num_threads : {1, 4, 16}) {
+        MemoryManager manager(0);
+        for (int m = 1; m <= num_models; ++m) {
+            manager.trackAllocation(m, 1024 * 1024);
+        }
+
+        std::atomic<int> total_ops{0};
+        auto start = Clock::now();
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&, t]() {
+                for (int i = 0; i < ops_per_thread; ++i) {
+                    auto handle = static_cast<ModelHandle>(1 + (t + i) % num_models);
+                    manager.incrementRefCount(handle);
+                    manager.recordAccess(handle);
+                    manager.decrementRefCount(handle);
+                }
+                total_ops.fetch_add(3 * ops_per_thread, std::memory_order_relaxed);
+            });
+        }
+
+        for (auto& th : threads) th.join();
+
+        auto end = Clock::now();
+        double elapsed_ms = std::chrono::duration<double, std::milli>(end - start).count();
+        double qps = elapsed_ms > 0.0 ? (total_ops.load() / elapsed_ms) * 1000.0 : 0.0;
+        qps_by_threads.push_back(qps);
+
+        for (int m = 1; m <= num_models; ++m) {
+            EXPECT_EQ(manager.getRefCount(m), 0);
+        }
+
+        std::cout << "[BENCH] MemoryManager hot path @" << num_threads << " threads: "
+                  << qps << " ops/s (" << elapsed_ms << "ms)\n";
+        g_results.push_back({"MemoryManager Hot Path x" + std::to_string(num_threads),
+            elapsed_ms, elapsed_ms, elapsed_ms, elapsed_ms, 0.0, total_ops.load(),
+            qps > 100000, "> 100k ops/sec"});
+    }
+
+    // Aggregate throughput should not collapse as threads are added
+    std::cout << "[BENCH] MemoryManager scaling 1->16 threads: "
+              << (qps_by_threads.front() > 0.0 ? qps_by_threads.back() / qps_by_threads.front() : 0.0)
+              << "x\n";
+}
+
+// =============================================================================
+// 22.2.7  Model Verification Throughput
+// =============================================================================
+
+TEST_F(PerformanceBenchmark, SHA256Throughput) {
+    // Every downloaded model is hashed in full, so MB/s here bounds how long
+    // verifying a multi-GB GGUF takes.
+    const size_t buffer_size = 64 * 1024 * 1024;
+    std::vector<uint8_t> data(buffer_size);
+    for (size_t i = 0; i < buffer_size; ++i) {
+        data[i] = static_cast<uint8_t>((i * 2654435761u) >> 24);
+    }
+
+    BenchmarkTimer memory_timer;
+    for (int i = 0; i < 3; ++i) {
+        memory_timer.start();
+        auto hash = crypto::SHA256::hash(data.data(), data.size());
+        memory_timer.stop();
+        EXPECT_EQ(crypto::SHA256::toHex(hash).length(), 64u);
+    }
+
+    double mb = static_cast<double>(buffer_size) / (1024.0 * 1024.0);
+    double memory_mbps = memory_timer.median() > 0.0 ? mb / (memory_timer.median() / 1000.0) : 0.0;
+
+    // File path, as used by download verification
+    const char* test_file = "/tmp/ondeviceai_sha256_bench.bin";
+    {
+        std::ofstream file(test_file, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(data.data()),
+                   static_cast<std::streamsize>(data.size()));
+    }
+
+    BenchmarkTimer file_timer;
+    for (int i = 0; i < 3; ++i) {
+        file_timer.start();
+        std::string hex = crypto::SHA256::hashFile(test_file);
+        file_timer.stop();
+        EXPECT_EQ(hex.length(), 64u);
+    }
+    std::remove(test_file);
+
+    double file_mbps = file_timer.median() > 0.0 ? mb / (file_timer.median() / 1000.0) : 0.0;
+
+    std::cout << "[BENCH] SHA-256 in-memory: " << memory_mbps << " MB/s, file: "
+              << file_mbps << " MB/s (4 GB model ~ "
+              << (file_mbps > 0.0 ? 4096.0 / file_mbps : 0.0) << "s)\n";
+
+    record_benchmark("SHA-256 In-Memory (64MB)", memory_timer, memory_mbps >= 100.0, ">= 100 MB/s");
+    record_benchmark("SHA-256 File (64MB)", file_timer, file_mbps >= 100.0, ">= 100 MB/s");
+}
+
+// =============================================================================
+// 22.2.8  Model Registry Parsing
+// =============================================================================
+
+TEST_F(PerformanceBenchmark, ModelRegistryParseTime) {
+    // The registry is parsed at startup; a few hundred models with several
+    // versions each is what the internal registry looks like today.
+    const ModelType types[] = {ModelType::LLM, ModelType::STT, ModelType::TTS};
+    std::map<std::string, ModelInfo> registry;
+    for (int m = 0; m < 100; ++m) {
+        for (int v = 0; v < 5; ++v) {
+            ModelInfo info;
+            // The registry is keyed by id, so every version needs its own
+            // or the parsed map collapses to 100 entries
+            info.id = "model-" + std::to_string(m) + "-v" + std::to_string(v);
+            info.name = "Benchmark Model " + std::to_string(m);
+            info.type = types[m % 3];
+            info.version = "1." + std::to_string(v) + ".0";
+            info.size_bytes = (100ULL + m) * 1024 * 1024;
+            info.download_url = "https://example.com/models/" + info.id + "/" + info.version + "/model.gguf";
+            info.checksum_sha256 = std::string(64, 'a' + static_cast<char>(v));
+            info.metadata["architecture"] = "transformer";
+            info.metadata["quantization"] = "q4_0";
+            info.metadata["description"] = "Registry entry with \"escaped\" text\nacross lines";
+            info.requirements.min_ram_bytes = 2ULL * 1024 * 1024 * 1024;
+            info.requirements.min_storage_bytes = info.size_bytes;
+            info.requirements.supported_platforms = {"iOS", "Android", "Linux", "macOS", "Windows"};
+            registry[info.id] = info;
+        }
+    }
+
+    ASSERT_EQ(registry.size(), 500u);
+
+    std::string json = json::serialize_model_registry(registry);
+    ASSERT_FALSE(json.empty());
+
+    BenchmarkTimer timer;
+    for (int i = 0; i < 10; ++i) {
+        timer.start();
+        auto result = json::deserialize_model_registry(json);
+        timer.stop();
+        ASSERT_TRUE(result.isSuccess());
+        EXPECT_EQ(result.value().size(), registry.size());
+    }
+
+    double kb = static_cast<double>(json.size()) / 1024.0;
+    double mbps = timer.median() > 0.0 ? (kb / 1024.0) / (timer.median() / 1000.0) : 0.0;
+
+    std::cout << "[BENCH] Registry parse: " << registry.size() << " entries, " << kb
+              << " KB, median " << timer.median() << "ms (" << mbps << " MB/s)\n";
+
+    record_benchmark("Model Registry Parse (500 entries)", timer,
+                     timer.median() < 20.0, "< 20ms");
+}
+
 // =============================================================================
 // Report generation (runs after all benchmarks)
 // =============================================================================
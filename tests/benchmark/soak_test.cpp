@@ -0,0 +1,488 @@
+// ==============================================================================
+// OnDevice AI SDK — Load & Soak Test
+//
+// Runs mixed LLM / STT / TTS workloads at a fixed concurrency for a
+// configurable duration under a tight memory limit, while:
+//   - randomly loading and unloading models (forcing LRU eviction)
+//   - unloading models other workers are using (cancellation races)
+//   - cancelling a running generation or transcription by unloading its
+//     model mid-run (the core has no per-request cancel call)
+//   - interrupting an ongoing VoicePipeline conversation
+//
+// Every sampling window records throughput, p50/p99 latency, RSS, callback
+// queue depth and eviction count to test_reports/soak_timeseries.csv for
+// charting. Fails on unexpected errors, RSS growth or throughput decay.
+//
+// Configuration (environment):
+//   ONDEVICEAI_BENCH_MODELS          fixtures directory (default ./models)
+//   ONDEVICEAI_SOAK_SECONDS          total duration (default 600)
+//   ONDEVICEAI_SOAK_THREADS          worker threads (default 4)
+//   ONDEVICEAI_SOAK_MEMORY_LIMIT_MB  SDK memory limit (default 512)
+//   ONDEVICEAI_SOAK_WINDOW_SECONDS   sampling window (default 10)
+//   ONDEVICEAI_SOAK_MAX_RSS_GROWTH_MB allowed RSS growth (default 64)
+//   ONDEVICEAI_SOAK_SEED             RNG seed (default random)
+// ==============================================================================
+
+#include <gtest/gtest.h>
+#include "ondeviceai/ondeviceai.hpp"
+#include "bench_fixtures.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__linux__)
+#include <unistd.h>
+#endif
+
+using namespace ondeviceai;
+using Clock = std::chrono::steady_clock;
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+namespace {
+
+/// Current resident set size in MB (Linux /proc, Windows working set;
+/// 0 where unavailable)
+double residentMB() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0.0;
+    return static_cast<double>(counters.WorkingSetSize) / (1024.0 * 1024.0);
+#elif defined(__linux__)
+    std::ifstream statm("/proc/self/statm");
+    long pages = 0, resident = 0;
+    if (!(statm >> pages >> resident)) return 0.0;
+    return resident * (static_cast<double>(sysconf(_SC_PAGESIZE)) / (1024.0 * 1024.0));
+#else
+    return 0.0;
+#endif
+}
+
+/// Errors the fault injection is expected to provoke
+bool isExpectedError(ErrorCode code) {
+    switch (code) {
+        case ErrorCode::InferenceModelNotLoaded:
+        case ErrorCode::InvalidInputModelHandle:
+        case ErrorCode::OperationCancelled:
+        case ErrorCode::ModelInsufficientMemory:
+        case ErrorCode::ResourceOutOfMemory:
+            return true;
+        default:
+            return false;
+    }
+}
+
+double percentile(std::vector<double> values, double p) {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    size_t idx = static_cast<size_t>(p / 100.0 * (values.size() - 1));
+    return values[idx];
+}
+
+enum ModelKind { LLM, STT, TTS, kKindCount };
+
+/// Unloads every model that loaded successfully when it goes out of scope,
+/// so early returns do not leave memory accounted to the SDK
+struct LoadedModels {
+    LLMEngine* llm;
+    STTEngine* stt;
+    TTSEngine* tts;
+    Result<ModelHandle> llm_handle;
+    Result<ModelHandle> stt_handle;
+    Result<ModelHandle> tts_handle;
+
+    ~LoadedModels() {
+        if (llm_handle.isSuccess()) llm->unloadModel(llm_handle.value());
+        if (stt_handle.isSuccess()) stt->unloadModel(stt_handle.value());
+        if (tts_handle.isSuccess()) tts->unloadModel(tts_handle.value());
+    }
+};
+
+/// Models loaded by the churn workers. Handles are copied out without
+/// holding the lock, so inference races with unload and eviction on purpose.
+struct ModelPool {
+    std::mutex mutex;
+    std::vector<ModelHandle> handles[kKindCount];
+    std::atomic<uint64_t> evictions{0};
+
+    bool pick(ModelKind kind, std::mt19937& rng, ModelHandle& out) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto& list = handles[kind];
+        if (list.empty()) return false;
+        out = list[std::uniform_int_distribution<size_t>(0, list.size() - 1)(rng)];
+        return true;
+    }
+
+    void add(ModelKind kind, ModelHandle handle) {
+        std::lock_guard<std::mutex> lock(mutex);
+        handles[kind].push_back(handle);
+    }
+
+    bool takeRandom(ModelKind kind, std::mt19937& rng, ModelHandle& out) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto& list = handles[kind];
+        if (list.empty()) return false;
+        size_t idx = std::uniform_int_distribution<size_t>(0, list.size() - 1)(rng);
+        out = list[idx];
+        list.erase(list.begin() + idx);
+        return true;
+    }
+};
+
+/// Per-window counters, swapped out by the sampler
+struct Window {
+    uint64_t ops = 0;
+    uint64_t expected_errors = 0;
+    uint64_t unexpected_errors = 0;
+    std::vector<double> latencies_ms;
+};
+
+struct Sample {
+    double elapsed_s;
+    double throughput;
+    double p50_ms;
+    double p99_ms;
+    double rss_mb;
+    size_t queue_depth;
+    uint64_t evictions;
+    uint64_t expected_errors;
+    uint64_t unexpected_errors;
+};
+
+} // namespace
+
+// =============================================================================
+// Test fixture
+// =============================================================================
+
+class SoakTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        SDKManager::shutdown();
+        auto config = bench::sdkConfig();
+        // Keep callbacks queued so the samples see real dispatcher depth
+        config.synchronous_callbacks = false;
+        config.memory_limit = static_cast<size_t>(
+            bench::envLong("ONDEVICEAI_SOAK_MEMORY_LIMIT_MB", 512)) * 1024 * 1024;
+        auto result = SDKManager::initialize(config);
+        if (result.isSuccess()) sdk_ = result.value();
+    }
+
+    void TearDown() override {
+        SDKManager::shutdown();
+        sdk_ = nullptr;
+    }
+
+    void record(double latency_ms, const Error* error) {
+        std::lock_guard<std::mutex> lock(window_mutex_);
+        window_.ops++;
+        window_.latencies_ms.push_back(latency_ms);
+        if (error) {
+            if (isExpectedError(error->code)) {
+                window_.expected_errors++;
+            } else {
+                window_.unexpected_errors++;
+                if (logged_errors_++ < 10) {
+                    std::cerr << "[SOAK] unexpected error: " << error->message << std::endl;
+                }
+            }
+        }
+    }
+
+    template <typename Fn>
+    void timed(Fn&& fn) {
+        auto start = Clock::now();
+        auto result = fn();
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        record(ms, result.isError() ? &result.error() : nullptr);
+    }
+
+    Window takeWindow() {
+        std::lock_guard<std::mutex> lock(window_mutex_);
+        Window out = std::move(window_);
+        window_ = Window{};
+        return out;
+    }
+
+    SDKManager* sdk_ = nullptr;
+    std::mutex window_mutex_;
+    Window window_;
+    int logged_errors_ = 0;
+};
+
+TEST_F(SoakTest, MixedWorkloadStability) {
+    const std::string llm_path = bench::fixturePath("bench-llm.gguf");
+    const std::string stt_path = bench::fixturePath("bench-stt.bin");
+    const std::string tts_path = bench::fixturePath("bench-tts.onnx");
+    const std::string speech_path = bench::fixturePath("bench-speech.wav");
+    if (!sdk_ || !bench::fileExists(llm_path) || !bench::fileExists(stt_path) ||
+        !bench::fileExists(tts_path) || !bench::fileExists(speech_path)) {
+        GTEST_SKIP() << "Soak fixtures not found in ONDEVICEAI_BENCH_MODELS";
+    }
+
+    auto speech = AudioData::fromFile(speech_path);
+    ASSERT_TRUE(speech.isSuccess()) << speech.error().message;
+
+    const auto duration = std::chrono::seconds(bench::envLong("ONDEVICEAI_SOAK_SECONDS", 600));
+    const auto window = std::chrono::seconds(
+        std::max(1L, bench::envLong("ONDEVICEAI_SOAK_WINDOW_SECONDS", 10)));
+    const int threads = static_cast<int>(std::max(1L, bench::envLong("ONDEVICEAI_SOAK_THREADS", 4)));
+    const unsigned seed = static_cast<unsigned>(
+        bench::envLong("ONDEVICEAI_SOAK_SEED", static_cast<long>(std::random_device{}())));
+    std::cout << "[SOAK] duration=" << duration.count() << "s threads=" << threads
+              << " seed=" << seed << std::endl;
+
+    auto* llm = sdk_->getLLMEngine();
+    auto* stt = sdk_->getSTTEngine();
+    auto* tts = sdk_->getTTSEngine();
+    auto* memory = sdk_->getMemoryManager();
+    auto* dispatcher = sdk_->getCallbackDispatcher();
+    const size_t baseline_usage = memory->getTotalMemoryUsage();
+    const std::string paths[kKindCount] = {llm_path, stt_path, tts_path};
+
+    ModelPool pool;
+    std::atomic<bool> running{true};
+    const auto deadline = Clock::now() + duration;
+
+    // Seed one model of each kind so workloads have something to run on
+    for (int k = 0; k < kKindCount; ++k) {
+        Result<ModelHandle> handle = k == LLM ? llm->loadModel(paths[k])
+                                   : k == STT ? stt->loadModel(paths[k])
+                                              : tts->loadModel(paths[k]);
+        ASSERT_TRUE(handle.isSuccess()) << handle.error().message;
+        pool.add(static_cast<ModelKind>(k), handle.value());
+    }
+
+    auto unload = [&](ModelKind kind, ModelHandle handle) {
+        if (kind == LLM) return llm->unloadModel(handle);
+        if (kind == STT) return stt->unloadModel(handle);
+        return tts->unloadModel(handle);
+    };
+
+    std::atomic<uint64_t> cancellations{0};
+    auto worker = [&](unsigned worker_seed) {
+        std::mt19937 rng(worker_seed);
+        std::discrete_distribution<int> pick_op({40, 20, 20, 10, 10, 5});
+        const char* prompts[] = {
+            "Write one sentence about the sea.",
+            "List three prime numbers.",
+            "Explain what a cache is in ten words.",
+        };
+        while (running.load() && Clock::now() < deadline) {
+            ModelHandle handle = 0;
+            switch (pick_op(rng)) {
+                case 0: {  // LLM generation
+                    if (!pool.pick(LLM, rng, handle)) break;
+                    GenerationConfig config;
+                    config.max_tokens = std::uniform_int_distribution<int>(8, 64)(rng);
+                    timed([&] {
+                        return llm->generateStreaming(handle, prompts[rng() % 3],
+                            [](const std::string&) {}, config);
+                    });
+                    break;
+                }
+                case 1:  // STT transcription
+                    if (!pool.pick(STT, rng, handle)) break;
+                    timed([&] { return stt->transcribe(handle, speech.value()); });
+                    break;
+                case 2:  // TTS synthesis
+                    if (!pool.pick(TTS, rng, handle)) break;
+                    timed([&] { return tts->synthesize(handle, "The quick brown fox jumps."); });
+                    break;
+                case 3: {  // Load another model; evicts LRU models under the limit
+                    auto kind = static_cast<ModelKind>(rng() % kKindCount);
+                    timed([&] {
+                        Result<ModelHandle> loaded = kind == LLM ? llm->loadModel(paths[kind])
+                                                   : kind == STT ? stt->loadModel(paths[kind])
+                                                                 : tts->loadModel(paths[kind]);
+                        if (loaded.isSuccess()) pool.add(kind, loaded.value());
+                        return loaded;
+                    });
+                    break;
+                }
+                case 4: {  // Unload, possibly while another worker is using it
+                    auto kind = static_cast<ModelKind>(rng() % kKindCount);
+                    if (!pool.takeRandom(kind, rng, handle)) break;
+                    timed([&] { return unload(kind, handle); });
+                    break;
+                }
+                case 5: {  // Cancel a running op: unload its private model mid-run
+                    const ModelKind kind = rng() % 2 == 0 ? LLM : STT;
+                    Result<ModelHandle> loaded = kind == LLM ? llm->loadModel(llm_path)
+                                                             : stt->loadModel(stt_path);
+                    if (loaded.isError()) {
+                        timed([&] { return loaded; });
+                        break;
+                    }
+                    handle = loaded.value();
+                    const auto delay = std::chrono::milliseconds(
+                        std::uniform_int_distribution<int>(5, 500)(rng));
+                    std::thread canceller([&, kind, handle, delay] {
+                        std::this_thread::sleep_for(delay);
+                        timed([&] { return unload(kind, handle); });
+                    });
+                    if (kind == LLM) {
+                        GenerationConfig config;
+                        config.max_tokens = 256;
+                        timed([&] {
+                            return llm->generateStreaming(handle, prompts[rng() % 3],
+                                [](const std::string&) {}, config);
+                        });
+                    } else {
+                        timed([&] { return stt->transcribe(handle, speech.value()); });
+                    }
+                    canceller.join();
+                    cancellations++;
+                    break;
+                }
+            }
+        }
+    };
+
+    // Voice conversations on a dedicated pipeline, interrupted at random
+    auto* pipeline = sdk_->getVoicePipeline();
+    std::atomic<uint64_t> interrupts{0};
+    std::thread voice_thread([&] {
+        LoadedModels models{llm, stt, tts, llm->loadModel(llm_path), stt->loadModel(stt_path),
+                            tts->loadModel(tts_path)};
+        if (models.llm_handle.isError() || models.stt_handle.isError() ||
+            models.tts_handle.isError()) {
+            return;
+        }
+        auto configured = pipeline->configure(models.stt_handle.value(), models.llm_handle.value(),
+                                              models.tts_handle.value(), PipelineConfig::defaults());
+        if (configured.isError()) return;
+
+        while (running.load() && Clock::now() < deadline) {
+            bool sent = false;
+            timed([&] {
+                return pipeline->startConversation(
+                    [&]() { if (sent) return AudioData{}; sent = true; return speech.value(); },
+                    [](const AudioData&) {},
+                    [](const std::string&) {},
+                    [](const std::string&) {});
+            });
+            pipeline->clearHistory();
+        }
+    });
+
+    std::thread interrupter([&, seed] {
+        std::mt19937 rng(seed ^ 0x5eedu);
+        std::uniform_int_distribution<int> delay_ms(200, 3000);
+        while (running.load() && Clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms(rng)));
+            if (pipeline->interrupt().isSuccess()) interrupts++;
+        }
+    });
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) workers.emplace_back(worker, seed + t + 1);
+
+    // Sampler: one row per window, plus eviction detection on pooled handles
+    std::vector<Sample> samples;
+    const auto start = Clock::now();
+    auto window_start = start;
+    while (Clock::now() < deadline) {
+        std::this_thread::sleep_until(std::min(Clock::now() + window, deadline));
+        {
+            std::lock_guard<std::mutex> lock(pool.mutex);
+            for (int k = 0; k < kKindCount; ++k) {
+                auto& list = pool.handles[k];
+                auto gone = std::remove_if(list.begin(), list.end(), [&](ModelHandle h) {
+                    return k == LLM ? !llm->isModelLoaded(h)
+                         : k == STT ? !stt->isModelLoaded(h)
+                                    : !tts->isModelLoaded(h);
+                });
+                pool.evictions += static_cast<uint64_t>(list.end() - gone);
+                list.erase(gone, list.end());
+            }
+        }
+
+        // The last window is cut short by the deadline and eviction checks
+        // take time, so divide by the span this window actually covered
+        Window w = takeWindow();
+        const auto now = Clock::now();
+        const double window_s = std::chrono::duration<double>(now - window_start).count();
+        window_start = now;
+        Sample s;
+        s.elapsed_s = std::chrono::duration<double>(now - start).count();
+        s.throughput = window_s > 0.0 ? w.ops / window_s : 0.0;
+        s.p50_ms = percentile(w.latencies_ms, 50);
+        s.p99_ms = percentile(w.latencies_ms, 99);
+        s.rss_mb = residentMB();
+        s.queue_depth = dispatcher ? dispatcher->getQueueSize() : 0;
+        s.evictions = pool.evictions.load();
+        s.expected_errors = w.expected_errors;
+        s.unexpected_errors = w.unexpected_errors;
+        samples.push_back(s);
+
+        printf("[SOAK] t=%7.0fs ops/s=%7.2f p50=%8.1fms p99=%8.1fms rss=%8.1fMB "
+               "queue=%-4zu evictions=%-6llu errors=%llu/%llu\n",
+               s.elapsed_s, s.throughput, s.p50_ms, s.p99_ms, s.rss_mb, s.queue_depth,
+               static_cast<unsigned long long>(s.evictions),
+               static_cast<unsigned long long>(s.expected_errors),
+               static_cast<unsigned long long>(s.unexpected_errors));
+    }
+
+    running = false;
+    pipeline->stopConversation();
+    for (auto& t : workers) t.join();
+    interrupter.join();
+    voice_thread.join();
+
+    for (int k = 0; k < kKindCount; ++k) {
+        for (ModelHandle h : pool.handles[k]) unload(static_cast<ModelKind>(k), h);
+    }
+
+    // Time series for charting
+    std::ofstream csv("test_reports/soak_timeseries.csv");
+    if (csv.is_open()) {
+        csv << "elapsed_s,ops_per_s,p50_ms,p99_ms,rss_mb,queue_depth,evictions,"
+               "expected_errors,unexpected_errors\n";
+        for (const auto& s : samples) {
+            csv << s.elapsed_s << "," << s.throughput << "," << s.p50_ms << "," << s.p99_ms << ","
+                << s.rss_mb << "," << s.queue_depth << "," << s.evictions << ","
+                << s.expected_errors << "," << s.unexpected_errors << "\n";
+        }
+    }
+    std::cout << "[SOAK] interrupts=" << interrupts.load()
+              << " cancellations=" << cancellations.load() << std::endl;
+
+    // Stability checks
+    uint64_t unexpected = 0;
+    for (const auto& s : samples) unexpected += s.unexpected_errors;
+    EXPECT_EQ(unexpected, 0u) << "Unexpected errors during soak";
+
+    EXPECT_EQ(memory->getTotalMemoryUsage(), baseline_usage)
+        << "MemoryManager accounting did not return to baseline";
+
+    if (samples.size() >= 4) {
+        // Compare the second window (after warm-up) with the last one
+        const Sample& early = samples[1];
+        const Sample& late = samples.back();
+        const double max_growth = static_cast<double>(
+            bench::envLong("ONDEVICEAI_SOAK_MAX_RSS_GROWTH_MB", 64));
+        if (early.rss_mb > 0) {
+            EXPECT_LT(late.rss_mb - early.rss_mb, max_growth)
+                << "RSS grew from " << early.rss_mb << "MB to " << late.rss_mb << "MB";
+        }
+        EXPECT_GT(late.throughput, early.throughput * 0.5)
+            << "Throughput decayed from " << early.throughput << " to " << late.throughput
+            << " ops/s";
+    }
+}
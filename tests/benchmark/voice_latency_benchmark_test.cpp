@@ -0,0 +1,309 @@
+// ==============================================================================
+// OnDevice AI SDK — End-to-End Voice Latency Harness
+//
+// Feeds recorded utterances through VoicePipeline at wall-clock rate and
+// timestamps, relative to end of speech:
+//   - transcript ready
+//   - LLM response ready (the pipeline reports the whole response at once)
+//   - first TTS audio chunk (mouth-to-ear latency)
+//   - last TTS audio chunk
+// and reports p50/p90/p99 across the corpus. Callbacks run synchronously
+// so each timestamp is taken where the pipeline raises the event.
+//
+// VoicePipeline treats every audio_input return as one complete utterance,
+// so each recording is handed over in a single callback once it has had
+// time to be "spoken", rather than in capture-sized chunks.
+//
+// Inputs (skipped when missing):
+//   $ONDEVICEAI_BENCH_MODELS   bench-stt.bin, bench-llm.gguf, bench-tts.onnx
+//                              (default ./models)
+//   $ONDEVICEAI_VOICE_CORPUS   directory of mono .wav utterances
+//                              (default <models>/voice_corpus)
+// ==============================================================================
+
+#include <gtest/gtest.h>
+#include "ondeviceai/ondeviceai.hpp"
+#include "bench_fixtures.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ondeviceai;
+using Clock = std::chrono::steady_clock;
+namespace fs = std::filesystem;
+
+namespace {
+
+double msBetween(Clock::time_point from, Clock::time_point to) {
+    return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+/// Timestamps for one utterance, all taken on the steady clock
+struct TurnTimeline {
+    std::string utterance;
+    Clock::time_point end_of_speech;
+    Clock::time_point transcript_ready;
+    Clock::time_point llm_response;
+    Clock::time_point first_audio;
+    Clock::time_point last_audio;
+    bool has_transcript = false;
+    bool has_llm = false;
+    bool has_audio = false;
+};
+
+struct Distribution {
+    std::vector<double> samples;
+    size_t dropped = 0;
+
+    /// Events stamped before end of speech mean the turn was mis-segmented;
+    /// they are counted, not folded into the percentiles
+    void add(double v) {
+        if (v < 0.0) { ++dropped; return; }
+        samples.push_back(v);
+    }
+
+    double percentile(double p) const {
+        if (samples.empty()) return 0.0;
+        auto sorted = samples;
+        std::sort(sorted.begin(), sorted.end());
+        size_t idx = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+        return sorted[std::min(idx, sorted.size() - 1)];
+    }
+};
+
+/**
+ * Plays `speech` into the pipeline in real time: the first capture() returns
+ * the whole utterance no earlier than the moment its last sample would have
+ * been spoken, and later calls return empty audio.
+ */
+class RealTimeUtterance {
+public:
+    explicit RealTimeUtterance(const AudioData& speech) : speech_(speech) {}
+
+    AudioData capture() {
+        if (delivered_) return AudioData();
+        start_ = Clock::now();
+        std::this_thread::sleep_until(endOfSpeech());
+        delivered_ = true;
+        return speech_;
+    }
+
+    /// Wall-clock instant the last speech sample was captured
+    Clock::time_point endOfSpeech() const {
+        auto us = static_cast<long long>(
+            1e6 * static_cast<double>(speech_.samples.size()) / speech_.sample_rate);
+        return start_ + std::chrono::microseconds(us);
+    }
+
+    bool delivered() const { return delivered_; }
+
+private:
+    const AudioData& speech_;
+    Clock::time_point start_;
+    bool delivered_ = false;
+};
+
+} // namespace
+
+// =============================================================================
+// Fixture
+// =============================================================================
+
+class VoiceLatencyBenchmark : public ::testing::Test {
+protected:
+    void SetUp() override {
+        const std::string dir = bench::modelsDir();
+        const std::string stt_path = dir + "/bench-stt.bin";
+        const std::string llm_path = dir + "/bench-llm.gguf";
+        const std::string tts_path = dir + "/bench-tts.onnx";
+        for (const auto& path : {stt_path, llm_path, tts_path}) {
+            if (!fs::exists(path)) GTEST_SKIP() << "Missing voice fixture: " << path;
+        }
+
+        const fs::path corpus_dir = bench::envOr("ONDEVICEAI_VOICE_CORPUS", dir + "/voice_corpus");
+        if (fs::is_directory(corpus_dir)) {
+            for (const auto& entry : fs::directory_iterator(corpus_dir)) {
+                if (entry.path().extension() == ".wav") corpus_.push_back(entry.path().string());
+            }
+        }
+        std::sort(corpus_.begin(), corpus_.end());
+        if (corpus_.empty()) GTEST_SKIP() << "No .wav utterances in " << corpus_dir;
+
+        SDKManager::shutdown();
+        // Synchronous callbacks, so every mark() is stamped on the pipeline
+        // thread when the event happens rather than when a dispatcher
+        // worker gets to it
+        auto init = SDKManager::initialize(bench::sdkConfig());
+        if (init.isError()) GTEST_SKIP() << "SDK init failed: " << init.error().message;
+        sdk_ = init.value();
+
+        auto stt = sdk_->getSTTEngine()->loadModel(stt_path);
+        auto llm = sdk_->getLLMEngine()->loadModel(llm_path);
+        auto tts = sdk_->getTTSEngine()->loadModel(tts_path);
+        if (stt.isError() || llm.isError() || tts.isError()) {
+            GTEST_SKIP() << "Failed to load voice fixtures";
+        }
+        stt_ = stt.value();
+        llm_ = llm.value();
+        tts_ = tts.value();
+    }
+
+    void TearDown() override {
+        if (sdk_) {
+            sdk_->getVoicePipeline()->stopConversation();
+            sdk_->getSTTEngine()->unloadModel(stt_);
+            sdk_->getLLMEngine()->unloadModel(llm_);
+            sdk_->getTTSEngine()->unloadModel(tts_);
+        }
+        SDKManager::shutdown();
+        sdk_ = nullptr;
+    }
+
+    /// Run one utterance as a single-turn conversation and timestamp it
+    TurnTimeline runTurn(const std::string& wav_path) {
+        TurnTimeline timeline;
+        timeline.utterance = fs::path(wav_path).filename().string();
+
+        auto loaded = AudioData::fromFile(wav_path);
+        if (loaded.isError()) return timeline;
+        AudioData speech = loaded.value();
+        if (speech.sample_rate != 16000) {
+            auto resampled = speech.resample(16000);
+            if (resampled.isError()) return timeline;
+            speech = resampled.value();
+        }
+
+        auto* pipeline = sdk_->getVoicePipeline();
+        pipeline->clearHistory();
+        if (pipeline->configure(stt_, llm_, tts_, PipelineConfig::defaults()).isError()) {
+            return timeline;
+        }
+
+        RealTimeUtterance source(speech);
+        std::mutex mutex;
+        std::condition_variable cv;
+        Clock::time_point last_event = Clock::now();
+
+        // Once the utterance is delivered, end the conversation after the response
+        // has been quiet for settle_ms (or the turn times out)
+        const auto settle = std::chrono::milliseconds(1000);
+        const auto timeout = std::chrono::seconds(60);
+
+        auto mark = [&](Clock::time_point& slot, bool& flag, bool update_last) {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto now = Clock::now();
+            if (!flag) { slot = now; flag = true; }
+            if (update_last) timeline.last_audio = now;
+            last_event = now;
+            cv.notify_all();
+        };
+
+        auto result = pipeline->startConversation(
+            [&]() -> AudioData {
+                if (!source.delivered()) {
+                    AudioData utterance = source.capture();
+                    timeline.end_of_speech = source.endOfSpeech();
+                    return utterance;
+                }
+                // Wait for the response to start, then for it to go quiet
+                std::unique_lock<std::mutex> lock(mutex);
+                auto deadline = Clock::now() + timeout;
+                cv.wait_until(lock, deadline, [&]() { return timeline.has_audio; });
+                while (Clock::now() < deadline && Clock::now() - last_event < settle) {
+                    cv.wait_until(lock, std::min(deadline, last_event + settle));
+                }
+                return AudioData();
+            },
+            [&](const AudioData&) { mark(timeline.first_audio, timeline.has_audio, true); },
+            [&](const std::string&) { mark(timeline.transcript_ready, timeline.has_transcript, false); },
+            [&](const std::string&) { mark(timeline.llm_response, timeline.has_llm, false); });
+
+        if (result.isError()) {
+            std::cout << "[BENCH]   " << timeline.utterance << ": "
+                      << result.error().message << "\n";
+        }
+        pipeline->stopConversation();
+        return timeline;
+    }
+
+    SDKManager* sdk_ = nullptr;
+    ModelHandle stt_ = 0;
+    ModelHandle llm_ = 0;
+    ModelHandle tts_ = 0;
+    std::vector<std::string> corpus_;
+};
+
+// =============================================================================
+// Mouth-to-ear latency across the corpus
+// =============================================================================
+
+TEST_F(VoiceLatencyBenchmark, MouthToEarLatencyDistribution) {
+    Distribution transcript, llm_response, first_audio, last_audio;
+    int completed = 0;
+
+    for (const auto& wav : corpus_) {
+        TurnTimeline t = runTurn(wav);
+        if (!t.has_audio) {
+            std::cout << "[BENCH]   " << t.utterance << ": no audio output\n";
+            continue;
+        }
+        ++completed;
+        if (t.has_transcript) transcript.add(msBetween(t.end_of_speech, t.transcript_ready));
+        if (t.has_llm) llm_response.add(msBetween(t.end_of_speech, t.llm_response));
+        first_audio.add(msBetween(t.end_of_speech, t.first_audio));
+        last_audio.add(msBetween(t.end_of_speech, t.last_audio));
+
+        std::cout << "[BENCH]   " << t.utterance
+                  << ": transcript=" << (t.has_transcript ? msBetween(t.end_of_speech, t.transcript_ready) : -1)
+                  << "ms llm_response=" << (t.has_llm ? msBetween(t.end_of_speech, t.llm_response) : -1)
+                  << "ms first_audio=" << msBetween(t.end_of_speech, t.first_audio)
+                  << "ms last_audio=" << msBetween(t.end_of_speech, t.last_audio) << "ms\n";
+    }
+
+    if (completed == 0) GTEST_SKIP() << "No utterance produced audio output";
+
+    struct Stage { const char* name; const Distribution* dist; };
+    const Stage stages[] = {
+        {"eos_to_transcript", &transcript},
+        {"eos_to_llm_response", &llm_response},
+        {"eos_to_first_audio", &first_audio},
+        {"eos_to_last_audio", &last_audio},
+    };
+
+    std::cout << "[BENCH] Voice latency over " << completed << "/" << corpus_.size()
+              << " utterances:\n";
+    for (const auto& s : stages) {
+        printf("[BENCH]   %-20s p50=%8.1fms  p90=%8.1fms  p99=%8.1fms  (n=%zu, dropped=%zu)\n",
+               s.name, s.dist->percentile(0.50), s.dist->percentile(0.90),
+               s.dist->percentile(0.99), s.dist->samples.size(), s.dist->dropped);
+    }
+
+    std::ofstream report("test_reports/voice_latency_report.json");
+    if (report.is_open()) {
+        report << "{\n  \"utterances\": " << corpus_.size()
+               << ",\n  \"completed\": " << completed << ",\n  \"stages\": {\n";
+        for (size_t i = 0; i < std::size(stages); ++i) {
+            const auto& s = stages[i];
+            report << "    \"" << s.name << "\": {\"p50_ms\": " << s.dist->percentile(0.50)
+                   << ", \"p90_ms\": " << s.dist->percentile(0.90)
+                   << ", \"p99_ms\": " << s.dist->percentile(0.99)
+                   << ", \"count\": " << s.dist->samples.size()
+                   << ", \"dropped\": " << s.dist->dropped << "}"
+                   << (i + 1 < std::size(stages) ? "," : "") << "\n";
+        }
+        report << "  }\n}\n";
+    }
+
+    EXPECT_GT(first_audio.percentile(0.50), 0.0);
+}